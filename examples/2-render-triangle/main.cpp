@@ -18,6 +18,8 @@ public:
         1.0f, 1.0f, 1.0f, 1.0f
     };
 
+    bool showGpuMemory = false;
+
     void onReady() override {
 
         float vertices[] = {
@@ -43,6 +45,7 @@ public:
         // Create a vertex array, and bind the vertex buffer and the index buffer into it
         m_vertexArray = std::make_shared<engine::VertexArray>();
         m_vertexArray->addBuffer(m_vertexBuffer, m_indexBuffer);
+        m_vertexArray->bind();
 
         std::map<engine::ShaderType, std::string> shaderSource {
             {engine::ShaderType::Vertex, "res/shaders/vertex-position.glsl"},
@@ -68,8 +71,13 @@ public:
 
         ImGui::Begin("Controls");
         ImGui::ColorPicker4("Color", color);
+        ImGui::Checkbox("GPU memory", &showGpuMemory);
         ImGui::End();
 
+        if (showGpuMemory) {
+            engine::GpuMemoryOverlay::render();
+        }
+
     }
 
 };
@@ -14,8 +14,8 @@ private:
 
     engine::Scene m_scene;
 
-    engine::SquareMesh m_quadMesh;
-    engine::TriangleMesh m_triangleMesh;
+    engine::PolygonMeshHandle m_quadMesh = engine::MeshLibrary::getInstance().getSquare();
+    engine::PolygonMeshHandle m_triangleMesh = engine::MeshLibrary::getInstance().getTriangle();
 
 public:
 
@@ -23,8 +23,8 @@ public:
 
         engine::Renderer::init();
         m_camera = std::make_shared<engine::OrthographicCamera>(viewportWidth, viewportHeight, 100);
-        std::shared_ptr<engine::Texture> texture1 = std::make_shared<engine::Texture>("assets/texture-1.jpeg");
-        std::shared_ptr<engine::Texture> texture2 = std::make_shared<engine::Texture>("assets/texture-2.jpeg");
+        std::shared_ptr<engine::Texture> texture1 = engine::TextureCache::getInstance().load("assets/texture-1.jpeg");
+        std::shared_ptr<engine::Texture> texture2 = engine::TextureCache::getInstance().load("assets/texture-2.jpeg");
 
         // TRIANGLE 1
         auto triangle1 = m_scene.createEntity();
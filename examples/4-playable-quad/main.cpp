@@ -31,7 +31,7 @@ private:
 
     std::shared_ptr<engine::OrthographicCamera> m_camera;
 
-    engine::SquareMesh m_quadMesh;
+    engine::PolygonMeshHandle m_quadMesh = engine::MeshLibrary::getInstance().getSquare();
 
     engine::Scene m_scene;
 
@@ -1,5 +1,9 @@
 #version 410 core
 
+// Variants:
+//  TEXTURED: multiply the color by the sampled texture (otherwise, color only)
+//  FADE: smooth the edges of the circle (otherwise, hard edges)
+
 // Inputs
 in vec2 v_localCoordinates;
 flat in float v_thickness;
@@ -11,20 +15,10 @@ in vec4 v_color;
 // Outputs
 out vec4 o_color;
 
-// Textures
-uniform sampler2D texture0;
-uniform sampler2D texture1;
-uniform sampler2D texture2;
-uniform sampler2D texture3;
-uniform sampler2D texture4;
-uniform sampler2D texture5;
-uniform sampler2D texture6;
-uniform sampler2D texture7;
-uniform sampler2D texture8;
-uniform sampler2D texture9;
-uniform sampler2D texture10;
+#ifdef TEXTURED
+#include "include/sample-texture-2d.glsl"
+#endif
 
-vec4 sampleTexture(int textureIndex, vec2 textureCoordinates);
 float getCirclePoint(vec2 localCoordinates, float thickness, float fade);
 
 void main() {
@@ -35,8 +29,12 @@ void main() {
       discard;
    }
 
+#ifdef TEXTURED
    vec4 textureColor = sampleTexture(v_textureIndex, v_textureCoordinates);
    o_color = textureColor * v_color;
+#else
+   o_color = v_color;
+#endif
    o_color *= circlePoint;
 
 }
@@ -44,39 +42,14 @@ void main() {
 float getCirclePoint(vec2 localCoordinates, float thickness, float fade) {
 
    float distance = 1.0f - length(localCoordinates);
+
+#ifdef FADE
    float circle = smoothstep(0.0f, fade, distance);
    circle *= smoothstep(thickness + fade, thickness, distance);
+#else
+   float circle = step(0.0f, distance) * step(distance, thickness);
+#endif
 
    return circle;
 
 }
-
-vec4 sampleTexture(int textureIndex, vec2 textureCoordinates) {
-
-   if (textureIndex == 0) {
-      return texture(texture0, textureCoordinates);
-   } else if (textureIndex == 1) {
-      return texture(texture1, textureCoordinates);
-   } else if (textureIndex == 2) {
-      return texture(texture2, textureCoordinates);
-   } else if (textureIndex == 3) {
-      return texture(texture3, textureCoordinates);
-   } else if (textureIndex == 4) {
-      return texture(texture4, textureCoordinates);
-   } else if (textureIndex == 5) {
-      return texture(texture5, textureCoordinates);
-   } else if (textureIndex == 6) {
-      return texture(texture6, textureCoordinates);
-   } else if (textureIndex == 7) {
-      return texture(texture7, textureCoordinates);
-   } else if (textureIndex == 8) {
-      return texture(texture8, textureCoordinates);
-   } else if (textureIndex == 9) {
-      return texture(texture9, textureCoordinates);
-   } else if (textureIndex == 10) {
-      return texture(texture10, textureCoordinates);
-   }
-
-   return vec4(1.0f, 1.0f, 1.0f, 1.0f);
-
-}
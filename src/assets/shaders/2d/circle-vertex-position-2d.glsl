@@ -1,7 +1,9 @@
 #version 410 core
 
-// Shader uniform
-uniform mat4 u_viewProjection;
+// Camera uniform block, shared by all the pipelines
+layout(std140) uniform Camera {
+   mat4 u_viewProjection;
+};
 
 // Vertex attributes
 layout(location = 0) in vec4 a_position;
@@ -0,0 +1,153 @@
+#include "AssetPack.h"
+#include "AssetPackFormat.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+
+namespace engine {
+
+    std::vector<std::shared_ptr<AssetPack> > AssetPack::m_mountedPacks;
+    std::mutex AssetPack::m_mountMutex;
+
+    AssetPack::AssetPack(const std::string& packPath, std::string mountPoint)
+        : m_file(packPath), m_mountPoint(std::filesystem::path(mountPoint).lexically_normal().generic_string()), m_entryCount(0) {
+
+        if (!m_file.isOpen()) {
+            return;
+        }
+
+        // A file too short for the header is as broken as one with the wrong magic
+        if (m_file.getSize() < sizeof(AssetPackHeader)) {
+            throw std::runtime_error("Invalid asset pack");
+        }
+
+        AssetPackHeader header{};
+        std::memcpy(&header, m_file.getData(), sizeof(AssetPackHeader));
+
+        if (header.m_magic != ASSET_PACK_MAGIC || header.m_version != ASSET_PACK_VERSION) {
+            throw std::runtime_error("Invalid asset pack");
+        }
+
+        // Divided rather than multiplied, so a huge entry count can't overflow past the check
+        if (header.m_entryCount > (m_file.getSize() - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry)) {
+            throw std::runtime_error("Invalid asset pack");
+        }
+
+        m_entryCount = header.m_entryCount;
+
+        if (!m_mountPoint.empty() && m_mountPoint.back() != '/') {
+            m_mountPoint += '/';
+        }
+
+    }
+
+    bool AssetPack::find(const std::string& path, const unsigned char*& data, size_t& size) const {
+
+        if (!isOpen()) {
+            return false;
+        }
+
+        std::string normalizedPath = std::filesystem::path(path).lexically_normal().generic_string();
+        if (normalizedPath.compare(0, m_mountPoint.size(), m_mountPoint) != 0) {
+            return false;
+        }
+
+        std::string relativePath = normalizedPath.substr(m_mountPoint.size());
+        uint64_t hash = hashAssetPath(relativePath);
+
+        // The index is sorted by hash, so binary search it in place
+        const unsigned char* index = m_file.getData() + sizeof(AssetPackHeader);
+        uint64_t low = 0;
+        uint64_t high = m_entryCount;
+        while (low < high) {
+
+            uint64_t middle = low + (high - low) / 2;
+            AssetPackEntry entry{};
+            std::memcpy(&entry, index + middle * sizeof(AssetPackEntry), sizeof(AssetPackEntry));
+
+            if (entry.m_pathHash < hash) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+
+        }
+
+        // Several entries can share the hash, compare the actual paths
+        for (uint64_t i = low; i < m_entryCount; i++) {
+
+            AssetPackEntry entry{};
+            std::memcpy(&entry, index + i * sizeof(AssetPackEntry), sizeof(AssetPackEntry));
+
+            if (entry.m_pathHash != hash) {
+                break;
+            }
+
+            uint64_t fileSize = m_file.getSize();
+            if (entry.m_pathOffset > fileSize || entry.m_pathLength > fileSize - entry.m_pathOffset || entry.m_dataOffset > fileSize || entry.m_dataSize > fileSize - entry.m_dataOffset) {
+                throw std::runtime_error("Invalid asset pack");
+            }
+
+            if (entry.m_pathLength == relativePath.size() && std::memcmp(m_file.getData() + entry.m_pathOffset, relativePath.data(), relativePath.size()) == 0) {
+                data = m_file.getData() + entry.m_dataOffset;
+                size = (size_t) entry.m_dataSize;
+                return true;
+            }
+
+        }
+
+        return false;
+
+    }
+
+    bool AssetPack::mount(const std::string& packPath, const std::string& mountPoint) {
+
+        auto pack = std::make_shared<AssetPack>(packPath, mountPoint);
+        if (!pack->isOpen()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mountMutex);
+        m_mountedPacks.push_back(pack);
+        return true;
+
+    }
+
+    void AssetPack::unmountAll() {
+        std::lock_guard<std::mutex> lock(m_mountMutex);
+        m_mountedPacks.clear();
+    }
+
+    std::shared_ptr<AssetPack> AssetPack::findMounted(const std::string& path, const unsigned char*& data, size_t& size) {
+
+        std::lock_guard<std::mutex> lock(m_mountMutex);
+
+        for (auto iterator = m_mountedPacks.rbegin(); iterator != m_mountedPacks.rend(); iterator++) {
+            if ((*iterator)->find(path, data, size)) {
+                return *iterator;
+            }
+        }
+
+        return nullptr;
+
+    }
+
+    AssetFile::AssetFile(const std::string& path)
+        : m_data(nullptr), m_size(0) {
+
+        m_pack = AssetPack::findMounted(path, m_data, m_size);
+        if (m_pack) {
+            return;
+        }
+
+        // Not packed (e.g. during development), map the loose file instead
+        m_looseFile = std::make_unique<MappedFile>(path);
+        if (m_looseFile->isOpen()) {
+            m_data = m_looseFile->getData();
+            m_size = m_looseFile->getSize();
+        }
+
+    }
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+    // A pack file, mapped in memory, serving its assets as spans of the mapping
+    class AssetPack {
+
+    public:
+        AssetPack(const std::string& packPath, std::string mountPoint);
+
+        inline bool isOpen() const {return m_file.isOpen();}
+
+        // Finds an asset by its full path (which must be under the mount point)
+        bool find(const std::string& path, const unsigned char*& data, size_t& size) const;
+
+        // Packs mounted here are searched by AssetFile, most recent first
+        static bool mount(const std::string& packPath, const std::string& mountPoint);
+        static void unmountAll();
+        static std::shared_ptr<AssetPack> findMounted(const std::string& path, const unsigned char*& data, size_t& size);
+
+    private:
+        MappedFile m_file;
+        std::string m_mountPoint;
+        uint64_t m_entryCount;
+
+        static std::vector<std::shared_ptr<AssetPack> > m_mountedPacks;
+        static std::mutex m_mountMutex;
+
+    };
+
+    // The read-only bytes of an asset: a span of a mounted pack if it's packed, or a mapped loose file otherwise
+    class AssetFile {
+
+    public:
+        explicit AssetFile(const std::string& path);
+
+        AssetFile(AssetFile const&) = delete;
+        void operator=(AssetFile const&) = delete;
+
+        inline bool isOpen() const {return m_data != nullptr;}
+        inline const unsigned char* getData() const {return m_data;}
+        inline size_t getSize() const {return m_size;}
+
+    private:
+        const unsigned char* m_data;
+        size_t m_size;
+        std::shared_ptr<AssetPack> m_pack; // Keeps the pack mapped, even if it's unmounted meanwhile
+        std::unique_ptr<MappedFile> m_looseFile;
+
+    };
+
+}
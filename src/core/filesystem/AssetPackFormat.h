@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// On-disk layout of an asset pack, written by tools/asset-packer:
+// an AssetPackHeader, followed by the AssetPackEntry index (sorted by path hash), followed by the paths and the asset data
+namespace engine {
+
+    struct AssetPackHeader {
+        uint32_t m_magic;
+        uint32_t m_version;
+        uint64_t m_entryCount;
+    };
+
+    struct AssetPackEntry {
+        uint64_t m_pathHash;
+        uint64_t m_pathOffset; // From the start of the file
+        uint64_t m_pathLength;
+        uint64_t m_dataOffset; // From the start of the file, aligned to ASSET_PACK_ALIGNMENT
+        uint64_t m_dataSize;
+    };
+
+    static const uint32_t ASSET_PACK_MAGIC = 0x4b504547; // "GEPK"
+    static const uint32_t ASSET_PACK_VERSION = 1;
+    static const uint64_t ASSET_PACK_ALIGNMENT = 16;
+
+    // FNV-1a, over the path relative to the pack root, with '/' separators
+    inline uint64_t hashAssetPath(const std::string& path) {
+
+        uint64_t hash = 14695981039346656037ull;
+        for (char character : path) {
+            hash ^= (unsigned char) character;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+
+    }
+
+}
@@ -0,0 +1,40 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine {
+
+    MappedFile::MappedFile(const std::string& path)
+        : m_data(nullptr), m_size(0) {
+
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) {
+            return;
+        }
+
+        struct stat fileStatus{};
+        if (fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0) {
+
+            void* data = mmap(nullptr, (size_t) fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if (data != MAP_FAILED) {
+                m_data = data;
+                m_size = (size_t) fileStatus.st_size;
+            }
+
+        }
+
+        // The mapping stays valid after closing the file descriptor
+        close(fileDescriptor);
+
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+    }
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace engine {
+
+    // Read-only memory mapping of a whole file. The data stays valid for the lifetime of the object
+    class MappedFile {
+
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        void operator=(MappedFile const&) = delete;
+
+        inline bool isOpen() const {return m_data != nullptr;}
+        inline const unsigned char* getData() const {return (const unsigned char*) m_data;}
+        inline size_t getSize() const {return m_size;}
+
+    private:
+        void* m_data;
+        size_t m_size;
+
+    };
+
+}
@@ -0,0 +1,78 @@
+#include "GpuMemoryOverlay.h"
+
+#include "../render/RenderCommand.h"
+
+#include <imgui.h>
+
+namespace engine {
+
+    static float toMegabytes(std::size_t bytes) {
+        return (float) bytes / (1024.0f * 1024.0f);
+    }
+
+    static void renderStats(const char* name, const GpuMemoryStats& stats) {
+
+        // Skip what was never allocated, to keep the window short
+        if (stats.m_peakCount == 0) {
+            return;
+        }
+
+        ImGui::Text("%-16s %8.2f MB (peak %8.2f MB)  %5u objects (peak %5u)", name, toMegabytes(stats.m_bytes), toMegabytes(stats.m_peakBytes), stats.m_count, stats.m_peakCount);
+
+    }
+
+    void GpuMemoryOverlay::render(unsigned int largestAllocationCount) {
+
+        const GpuMemoryTracker& tracker = RenderCommand::getMemoryTracker();
+
+        ImGui::Begin("GPU memory");
+
+        renderStats("Total", tracker.getTotalStats());
+        ImGui::Separator();
+
+        const GpuMemoryCategory categories[] = {
+            GpuMemoryCategory::VertexBuffer,
+            GpuMemoryCategory::IndexBuffer,
+            GpuMemoryCategory::UniformBuffer,
+            GpuMemoryCategory::PixelBuffer,
+            GpuMemoryCategory::IndirectBuffer,
+            GpuMemoryCategory::Texture,
+            GpuMemoryCategory::Framebuffer
+        };
+        for (GpuMemoryCategory category : categories) {
+            renderStats(GpuMemoryTracker::getCategoryName(category), tracker.getStats(category));
+        }
+
+        if (ImGui::CollapsingHeader("Textures by format")) {
+
+            const TextureFormat formats[] = {
+                TextureFormat::R8,
+                TextureFormat::RG8,
+                TextureFormat::A8,
+                TextureFormat::RGB8,
+                TextureFormat::RGBA8,
+                TextureFormat::SRGB8,
+                TextureFormat::SRGB8_ALPHA8,
+                TextureFormat::BC1,
+                TextureFormat::BC3
+            };
+            for (TextureFormat format : formats) {
+                renderStats(GpuMemoryTracker::getFormatName(format), tracker.getStats(format));
+            }
+
+        }
+
+        if (ImGui::CollapsingHeader("Largest objects")) {
+
+            for (const auto& allocation : tracker.getLargestAllocations(largestAllocationCount)) {
+                const char* label = allocation.m_label.empty() ? "(unlabeled)" : allocation.m_label.c_str();
+                ImGui::Text("%8.2f MB  %-16s %s", toMegabytes(allocation.m_size), GpuMemoryTracker::getCategoryName(allocation.m_category), label);
+            }
+
+        }
+
+        ImGui::End();
+
+    }
+
+}
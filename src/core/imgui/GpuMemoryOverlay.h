@@ -0,0 +1,15 @@
+#pragma once
+
+namespace engine {
+
+    // A debug window with the video memory the render API has allocated, per category and texture format.
+    // Call it from Application::onGuiRender
+    class GpuMemoryOverlay {
+
+    public:
+
+        static void render(unsigned int largestAllocationCount = 10);
+
+    };
+
+}
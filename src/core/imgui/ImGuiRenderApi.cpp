@@ -1,11 +1,52 @@
 #include "ImGuiRenderApi.h"
 
+#include "../render/RenderCommand.h"
+
 #include <imgui.h>
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
 
+#include <cstring>
+#include <vector>
+
 namespace engine {
 
+    // A frame's draw data, copied, so the render thread can draw it while ImGui builds the next frame
+    struct ImGuiFrameCopy {
+        ImDrawData m_drawData;
+        std::vector<ImDrawList*> m_drawLists; // Kept from frame to frame, so copying reuses their memory
+    };
+
+    // Double buffered, like the render thread's command buffers: it's at most one frame behind
+    static ImGuiFrameCopy frameCopies[2];
+    static unsigned int frameCopyIndex = 0;
+
+    template<typename T>
+    static void copyVector(ImVector<T>& destination, const ImVector<T>& source) {
+        destination.resize(source.Size);
+        if (source.Size) {
+            std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+        }
+    }
+
+    static void copyDrawData(const ImDrawData* source, ImGuiFrameCopy& copy) {
+
+        while (copy.m_drawLists.size() < (std::size_t) source->CmdListsCount) {
+            copy.m_drawLists.push_back(IM_NEW(ImDrawList)(::ImGui::GetDrawListSharedData()));
+        }
+
+        // Only what the renderer reads
+        for (int i = 0; i < source->CmdListsCount; i++) {
+            copyVector(copy.m_drawLists[i]->CmdBuffer, source->CmdLists[i]->CmdBuffer);
+            copyVector(copy.m_drawLists[i]->IdxBuffer, source->CmdLists[i]->IdxBuffer);
+            copyVector(copy.m_drawLists[i]->VtxBuffer, source->CmdLists[i]->VtxBuffer);
+        }
+
+        copy.m_drawData = *source;
+        copy.m_drawData.CmdLists = copy.m_drawLists.data();
+
+    }
+
     void ImGuiRenderApi::init(GLFWwindow* windowContext) {
 
         ::ImGui::CreateContext();
@@ -15,6 +56,9 @@ namespace engine {
         ImGui_ImplOpenGL3_Init();
         ::ImGui::StyleColorsDark();
 
+        // Created up front, otherwise the first new frame would create them, maybe away from the context's thread
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+
     }
 
     void ImGuiRenderApi::newFrame() {
@@ -28,12 +72,33 @@ namespace engine {
     void ImGuiRenderApi::render() {
 
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+        if (!RenderCommand::isRenderThreadRunning()) {
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            return;
+        }
+
+        // The draw data is only valid until the next frame, so the render thread draws a copy, with the rest of the frame
+        ImGuiFrameCopy& copy = frameCopies[frameCopyIndex];
+        frameCopyIndex = 1 - frameCopyIndex;
+        copyDrawData(ImGui::GetDrawData(), copy);
+
+        ImDrawData* drawData = &copy.m_drawData;
+        RenderCommand::defer([drawData]() {
+            ImGui_ImplOpenGL3_RenderDrawData(drawData);
+        });
 
     }
 
     void ImGuiRenderApi::shutdown() {
 
+        for (auto& copy : frameCopies) {
+            for (auto drawList : copy.m_drawLists) {
+                IM_DELETE(drawList);
+            }
+            copy.m_drawLists.clear();
+        }
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -0,0 +1,67 @@
+#include "DeletionQueue.h"
+
+#include "RenderCommand.h"
+
+namespace engine {
+
+    void DeletionQueue::enqueue(GpuResourceType type, unsigned int id) {
+
+        if (!id) {
+            return;
+        }
+
+        m_currentDeletions.push_back({type, id});
+        m_pendingCount++;
+
+    }
+
+    void DeletionQueue::collect() {
+
+        if (!m_currentDeletions.empty()) {
+            m_frames.push_back({RenderCommand::createFence(), std::move(m_currentDeletions)});
+            m_currentDeletions.clear();
+        }
+
+        // Frames finish in order, so stop at the first one still in flight
+        while (!m_frames.empty() && RenderCommand::isFenceSignaled(m_frames.front().m_fence)) {
+            RenderCommand::deleteFence(m_frames.front().m_fence);
+            retire(m_frames.front().m_deletions);
+            m_frames.pop_front();
+        }
+
+    }
+
+    void DeletionQueue::flush() {
+
+        for (auto& frame : m_frames) {
+            RenderCommand::deleteFence(frame.m_fence);
+            retire(frame.m_deletions);
+        }
+        m_frames.clear();
+
+        retire(m_currentDeletions);
+        m_currentDeletions.clear();
+
+    }
+
+    void DeletionQueue::retire(std::vector<Deletion>& deletions) {
+
+        for (auto& deletion : deletions) {
+            switch (deletion.m_type) {
+                case GpuResourceType::Buffer:
+                    RenderCommand::deleteBuffer(deletion.m_id);
+                    break;
+                case GpuResourceType::VertexArray:
+                    RenderCommand::deleteVertexArray(deletion.m_id);
+                    break;
+                case GpuResourceType::Texture:
+                    RenderCommand::deleteTexture(deletion.m_id);
+                    break;
+            }
+        }
+
+        m_pendingCount -= deletions.size();
+
+    }
+
+}
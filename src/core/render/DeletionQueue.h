@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RenderApi.h"
+
+#include <deque>
+#include <vector>
+
+namespace engine {
+
+    // Defers deleting GL objects until the GPU is done with them: every frame's deletions are fenced, and only
+    // retired once that fence has signaled, so the driver never has to stall for an object still in flight
+    class DeletionQueue {
+
+    private:
+        DeletionQueue() = default;
+
+    public:
+        static DeletionQueue& getInstance() {
+            static DeletionQueue m_instance;
+            return m_instance;
+        }
+        DeletionQueue(DeletionQueue const&) = delete;
+        void operator=(DeletionQueue const&) = delete;
+
+        void enqueue(GpuResourceType type, unsigned int id);
+
+        // Fences this frame's deletions, and retires those of the frames the GPU has finished. Called once per frame by the run loop
+        void collect();
+        // Retires everything right away, e.g. before the context is destroyed
+        void flush();
+
+        inline unsigned int getPendingCount() const {return m_pendingCount;}
+
+    private:
+
+        struct Deletion {
+            GpuResourceType m_type;
+            unsigned int m_id;
+        };
+
+        struct Frame {
+            void* m_fence;
+            std::vector<Deletion> m_deletions;
+        };
+
+        std::vector<Deletion> m_currentDeletions;
+        std::deque<Frame> m_frames;
+        unsigned int m_pendingCount = 0;
+
+        void retire(std::vector<Deletion>& deletions);
+
+    };
+
+}
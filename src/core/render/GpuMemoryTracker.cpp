@@ -0,0 +1,175 @@
+#include "GpuMemoryTracker.h"
+
+#include <algorithm>
+
+namespace engine {
+
+    void GpuMemoryTracker::trackBuffer(unsigned int id, GpuMemoryCategory category, std::size_t size) {
+
+        // Re-specifying a buffer's storage replaces its previous size
+        release(GpuResourceType::Buffer, id);
+
+        m_allocations[getKey(GpuResourceType::Buffer, id)] = {category, TextureFormat::RGBA8, size, ""};
+        add(m_categoryStats[category], size, true);
+        add(m_totalStats, size, true);
+
+    }
+
+    void GpuMemoryTracker::trackTexture(unsigned int id, TextureFormat format, std::size_t size) {
+
+        auto iterator = m_allocations.find(getKey(GpuResourceType::Texture, id));
+        bool isNew = iterator == m_allocations.end();
+
+        if (isNew) {
+            m_allocations[getKey(GpuResourceType::Texture, id)] = {GpuMemoryCategory::Texture, format, size, ""};
+        } else {
+            iterator->second.m_format = format;
+            iterator->second.m_size += size;
+        }
+
+        add(m_categoryStats[GpuMemoryCategory::Texture], size, isNew);
+        add(m_formatStats[format], size, isNew);
+        add(m_totalStats, size, isNew);
+
+    }
+
+    void GpuMemoryTracker::release(GpuResourceType type, unsigned int id) {
+
+        auto iterator = m_allocations.find(getKey(type, id));
+        if (iterator == m_allocations.end()) {
+            return;
+        }
+
+        const GpuAllocation& allocation = iterator->second;
+
+        remove(m_categoryStats[allocation.m_category], allocation.m_size);
+        if (allocation.m_category == GpuMemoryCategory::Texture) {
+            remove(m_formatStats[allocation.m_format], allocation.m_size);
+        }
+        remove(m_totalStats, allocation.m_size);
+
+        m_allocations.erase(iterator);
+
+    }
+
+    void GpuMemoryTracker::setLabel(GpuResourceType type, unsigned int id, const std::string& label) {
+
+        auto iterator = m_allocations.find(getKey(type, id));
+        if (iterator != m_allocations.end()) {
+            iterator->second.m_label = label;
+        }
+
+    }
+
+    GpuMemoryStats GpuMemoryTracker::getStats(GpuMemoryCategory category) const {
+        auto iterator = m_categoryStats.find(category);
+        return iterator != m_categoryStats.end() ? iterator->second : GpuMemoryStats();
+    }
+
+    GpuMemoryStats GpuMemoryTracker::getStats(TextureFormat format) const {
+        auto iterator = m_formatStats.find(format);
+        return iterator != m_formatStats.end() ? iterator->second : GpuMemoryStats();
+    }
+
+    std::vector<GpuAllocation> GpuMemoryTracker::getLargestAllocations(unsigned int count) const {
+
+        std::vector<GpuAllocation> allocations;
+        allocations.reserve(m_allocations.size());
+        for (const auto& allocation : m_allocations) {
+            allocations.push_back(allocation.second);
+        }
+
+        count = std::min(count, (unsigned int) allocations.size());
+        std::partial_sort(allocations.begin(), allocations.begin() + count, allocations.end(), [](const GpuAllocation& a, const GpuAllocation& b) {
+            return a.m_size > b.m_size;
+        });
+        allocations.resize(count);
+
+        return allocations;
+
+    }
+
+    std::size_t GpuMemoryTracker::getTextureLevelSize(TextureFormat format, unsigned int width, unsigned int height) {
+
+        // Block compressed formats store 4x4 blocks, of 8 bytes (BC1) or 16 bytes (BC3)
+        std::size_t blockCount = (std::size_t) ((width + 3) / 4) * ((height + 3) / 4);
+
+        switch (format) {
+            case TextureFormat::R8:
+            case TextureFormat::A8:
+                return (std::size_t) width * height;
+            case TextureFormat::RG8:
+                return (std::size_t) width * height * 2;
+            case TextureFormat::RGB8:
+            case TextureFormat::SRGB8:
+                return (std::size_t) width * height * 3;
+            case TextureFormat::RGBA8:
+            case TextureFormat::SRGB8_ALPHA8:
+                return (std::size_t) width * height * 4;
+            case TextureFormat::BC1:
+                return blockCount * 8;
+            case TextureFormat::BC3:
+                return blockCount * 16;
+        }
+
+        return 0;
+
+    }
+
+    const char* GpuMemoryTracker::getCategoryName(GpuMemoryCategory category) {
+
+        switch (category) {
+            case GpuMemoryCategory::VertexBuffer:         return "Vertex buffers";
+            case GpuMemoryCategory::IndexBuffer:          return "Index buffers";
+            case GpuMemoryCategory::UniformBuffer:        return "Uniform buffers";
+            case GpuMemoryCategory::PixelBuffer:          return "Pixel buffers";
+            case GpuMemoryCategory::IndirectBuffer:       return "Indirect draw buffers";
+            case GpuMemoryCategory::Texture:              return "Textures";
+            case GpuMemoryCategory::Framebuffer:          return "Framebuffers";
+        }
+
+        return "Unknown";
+
+    }
+
+    const char* GpuMemoryTracker::getFormatName(TextureFormat format) {
+
+        switch (format) {
+            case TextureFormat::R8:                       return "R8";
+            case TextureFormat::RG8:                      return "RG8";
+            case TextureFormat::A8:                       return "A8";
+            case TextureFormat::RGB8:                     return "RGB8";
+            case TextureFormat::RGBA8:                    return "RGBA8";
+            case TextureFormat::SRGB8:                    return "SRGB8";
+            case TextureFormat::SRGB8_ALPHA8:             return "SRGB8_ALPHA8";
+            case TextureFormat::BC1:                      return "BC1";
+            case TextureFormat::BC3:                      return "BC3";
+        }
+
+        return "Unknown";
+
+    }
+
+    uint64_t GpuMemoryTracker::getKey(GpuResourceType type, unsigned int id) {
+        // Buffers and textures have separate id namespaces in GL
+        return ((uint64_t) type << 32) | id;
+    }
+
+    void GpuMemoryTracker::add(GpuMemoryStats& stats, std::size_t size, bool isNew) {
+
+        stats.m_bytes += size;
+        stats.m_peakBytes = std::max(stats.m_peakBytes, stats.m_bytes);
+
+        if (isNew) {
+            stats.m_count++;
+            stats.m_peakCount = std::max(stats.m_peakCount, stats.m_count);
+        }
+
+    }
+
+    void GpuMemoryTracker::remove(GpuMemoryStats& stats, std::size_t size) {
+        stats.m_bytes -= size;
+        stats.m_count--;
+    }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "RenderApi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    enum class GpuMemoryCategory {
+        VertexBuffer,
+        IndexBuffer,
+        UniformBuffer,
+        PixelBuffer,
+        IndirectBuffer,
+        Texture,
+        Framebuffer
+    };
+
+    struct GpuMemoryStats {
+        std::size_t m_bytes = 0;
+        std::size_t m_peakBytes = 0;
+        unsigned int m_count = 0;
+        unsigned int m_peakCount = 0;
+    };
+
+    struct GpuAllocation {
+        GpuMemoryCategory m_category;
+        TextureFormat m_format; // Only meaningful for textures
+        std::size_t m_size;
+        std::string m_label;
+    };
+
+    // Accounts for the video memory of the live GPU objects, from the sizes the render API hands to the driver.
+    // It's an estimate: drivers pad and align on their own, but it's the same estimate every frame
+    class GpuMemoryTracker {
+
+    public:
+
+        void trackBuffer(unsigned int id, GpuMemoryCategory category, std::size_t size);
+        // Adds to the texture's size, since textures are uploaded level by level
+        void trackTexture(unsigned int id, TextureFormat format, std::size_t size);
+        void release(GpuResourceType type, unsigned int id);
+
+        void setLabel(GpuResourceType type, unsigned int id, const std::string& label);
+
+        GpuMemoryStats getStats(GpuMemoryCategory category) const;
+        GpuMemoryStats getStats(TextureFormat format) const;
+        inline const GpuMemoryStats& getTotalStats() const {return m_totalStats;}
+
+        // The biggest live objects, largest first
+        std::vector<GpuAllocation> getLargestAllocations(unsigned int count) const;
+
+        static std::size_t getTextureLevelSize(TextureFormat format, unsigned int width, unsigned int height);
+        static const char* getCategoryName(GpuMemoryCategory category);
+        static const char* getFormatName(TextureFormat format);
+
+    private:
+
+        std::unordered_map<uint64_t, GpuAllocation> m_allocations;
+        std::map<GpuMemoryCategory, GpuMemoryStats> m_categoryStats;
+        std::map<TextureFormat, GpuMemoryStats> m_formatStats;
+        GpuMemoryStats m_totalStats;
+
+        static uint64_t getKey(GpuResourceType type, unsigned int id);
+        static void add(GpuMemoryStats& stats, std::size_t size, bool isNew);
+        static void remove(GpuMemoryStats& stats, std::size_t size);
+
+    };
+
+}
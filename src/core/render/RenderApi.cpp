@@ -1,8 +1,12 @@
 #include "RenderCommand.h"
 #include "opengl/OpenGLRenderAPI.h"
+#include "threaded/ThreadedRenderApi.h"
 
 namespace engine {
 
-    RenderApi& RenderCommand::m_apiInstance = OpenGLRenderApi::getInstance();
+#ifndef STATIC_RENDER_API
+    thread_local RenderApi* RenderCommand::m_apiInstance = &OpenGLRenderApi::getInstance();
+#endif
+    std::unique_ptr<ThreadedRenderApi> RenderCommand::m_threadedApi;
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace engine {
 
@@ -17,6 +19,70 @@ namespace engine {
         Fragment
     };
 
+    enum class TextureFormat {
+        R8, // Read as (r, r, r, 1), grayscale
+        RG8, // Read as (r, r, r, g), grayscale with alpha
+        A8, // Stored as R8, read as (1, 1, 1, r), for masks and fonts
+        RGB8,
+        RGBA8,
+        SRGB8, // Decoded to linear when sampled
+        SRGB8_ALPHA8,
+        BC1,
+        BC3
+    };
+
+    enum class GpuResourceType {
+        Buffer,
+        VertexArray,
+        Texture
+    };
+
+    // Options for mapping a buffer range for writing, combined with |
+    enum class BufferMapFlags : unsigned int {
+        None = 0,
+        InvalidateRange = 1 << 0,   // The range's previous contents won't be read
+        InvalidateBuffer = 1 << 1,  // None of the buffer's previous contents will be read, so it can be orphaned
+        Unsynchronized = 1 << 2     // Don't wait for the GPU, the caller guarantees it isn't using the range
+    };
+
+    inline BufferMapFlags operator|(BufferMapFlags left, BufferMapFlags right) {
+        return (BufferMapFlags) ((unsigned int) left | (unsigned int) right);
+    }
+
+    inline bool hasFlags(BufferMapFlags flags, BufferMapFlags mask) {
+        return ((unsigned int) flags & (unsigned int) mask) == (unsigned int) mask;
+    }
+
+    enum class ShaderUniformType {
+        Int,
+        Float,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat3,
+        Mat4,
+        Sampler2D,
+        Other
+    };
+
+    struct ShaderUniform {
+        std::string m_name;
+        int m_location;
+        ShaderUniformType m_type;
+        int m_count;
+    };
+
+    // One draw of a multi-draw, laid out the way glMultiDrawElementsIndirect reads it
+    struct DrawIndexedCommand {
+        unsigned int m_indexCount;
+        unsigned int m_instanceCount;
+        unsigned int m_firstIndex;
+        int m_baseVertex; // Added to every index, so a batch's indices can start at 0
+        unsigned int m_baseInstance;
+    };
+
+    class GpuMemoryTracker;
+
     class RenderApi {
 
     public:
@@ -33,10 +99,27 @@ namespace engine {
         virtual void unbindVertexBuffer() = 0;
 
         virtual void createIndexBuffer(unsigned int& id, unsigned int* data, unsigned int count) = 0;
+        virtual void createIndexBuffer(unsigned int& id, unsigned int count) = 0;
         virtual void bindIndexBuffer(unsigned int& id) = 0;
         virtual void unbindIndexBuffer() = 0;
 
+        virtual void createUniformBuffer(unsigned int& id, unsigned int size) = 0;
+        virtual void bindUniformBuffer(unsigned int& id) = 0;
+        virtual void bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint) = 0;
+        virtual void submitUniformBufferData(const void *data, unsigned int size, unsigned int offset) = 0;
+        virtual void unbindUniformBuffer() = 0;
+
+        virtual void createPixelBuffer(unsigned int& id, unsigned int size) = 0;
+        virtual void bindPixelBuffer(unsigned int& id) = 0;
+        virtual void* mapPixelBuffer(unsigned int size) = 0;
+        virtual bool unmapPixelBuffer() = 0; // False if the contents were lost meanwhile, and have to be written again
+        virtual void unbindPixelBuffer() = 0;
+
         virtual void deleteBuffer(unsigned int& id) = 0;
+        virtual void submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset) = 0;
+        virtual void* mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags) = 0;
+        virtual void unmapBuffer(unsigned int id) = 0;
+        virtual void copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size) = 0;
 
         virtual void createVertexArray(unsigned int& id) = 0;
         virtual void bindVertexArray(unsigned int& id) = 0;
@@ -44,12 +127,20 @@ namespace engine {
         virtual void deleteVertexArray(unsigned int& id) = 0;
 
         virtual unsigned int createShaderProgram() = 0;
-        virtual unsigned int compileShader(ShaderType type, const std::string& source) = 0;
         virtual void attachShader(unsigned id, unsigned int shaderId) = 0;
         virtual void deleteShader(unsigned int id) = 0;
-        virtual void compileShaderProgram(unsigned int id) = 0;
+        virtual unsigned int submitShader(ShaderType type, const std::string& source) = 0;
+        virtual bool checkShader(unsigned int shaderId) = 0;
+        virtual void submitShaderProgram(unsigned int id) = 0;
+        virtual bool isShaderProgramReady(unsigned int id) = 0;
+        virtual bool checkShaderProgram(unsigned int id) = 0;
         virtual void bindShader(unsigned int id) = 0;
 
+        virtual bool supportsShaderProgramBinary() = 0;
+        virtual std::string getDriverSignature() = 0;
+        virtual void getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary) = 0;
+        virtual bool loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size) = 0;
+
         virtual unsigned int getUniformLocation(unsigned int id, const std::string& name) = 0;
         virtual void setUniform1i(int location, int value) = 0;
         virtual void setUniform3f(int location, const glm::vec3& value) = 0;
@@ -57,15 +148,39 @@ namespace engine {
         virtual void setUniformMat3f(int location, const glm::mat3& value) = 0;
         virtual void setUniformMat4f(int location, const glm::mat4& value) = 0;
 
-        virtual unsigned int sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type) = 0;
-        virtual void addVertexArrayAttribute(unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int stride, int offset) = 0;
+        virtual void getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms) = 0;
+        virtual void setProgramUniform1i(unsigned int id, int location, int value) = 0;
+        virtual void setProgramUniform3f(unsigned int id, int location, const glm::vec3& value) = 0;
+        virtual void setProgramUniform4f(unsigned int id, int location, const glm::vec4& value) = 0;
+        virtual void setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value) = 0;
+        virtual void setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value) = 0;
+
+        virtual unsigned int getUniformBlockIndex(unsigned int id, const std::string& name) = 0;
+        virtual void setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint) = 0;
 
-        virtual void loadTexture(unsigned int& id, unsigned int width, unsigned int height, void* data) = 0;
+        virtual unsigned int sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type) = 0;
+        virtual void addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset) = 0;
+        virtual void setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride) = 0;
+        virtual void setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId) = 0;
+
+        virtual void loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data) = 0;
+        virtual void createTexture(unsigned int& id, unsigned int levelCount) = 0;
+        virtual void loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size) = 0;
+        virtual void updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data) = 0;
+        virtual void generateTextureMipmaps(unsigned int id) = 0;
         virtual void bindTexture(unsigned int id, unsigned int slot) = 0;
         virtual void deleteTexture(unsigned int& id) = 0;
 
         virtual void drawIndexedTriangles(unsigned int indexCount) = 0;
         virtual void drawIndexedLines(unsigned int indexCount) = 0;
+        virtual void drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count) = 0;
+
+        virtual void* createFence() = 0;
+        virtual bool isFenceSignaled(void* fence) = 0;
+        virtual void deleteFence(void* fence) = 0;
+
+        virtual void setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label) = 0;
+        virtual const GpuMemoryTracker& getMemoryTracker() = 0;
 
     };
 
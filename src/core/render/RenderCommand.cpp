@@ -1,11 +1,86 @@
 #include "RenderCommand.h"
+#include "threaded/ThreadedRenderApi.h"
+
+#ifdef STATIC_RENDER_API
+#include "opengl/OpenGLRenderAPI.h"
+#endif
+
+#include <stdexcept>
+#include <utility>
 
 namespace engine {
 
+#ifdef STATIC_RENDER_API
+    // Defined before every use, so it's inlined into each of them
+    inline OpenGLRenderApi& RenderCommand::getApi() {
+        return OpenGLRenderApi::getInstance();
+    }
+#endif
+
     void RenderCommand::init() {
         getApi().init();
     }
 
+    void RenderCommand::startRenderThread(const std::shared_ptr<Window>& window) {
+
+#ifdef STATIC_RENDER_API
+        throw std::runtime_error("The render thread needs the virtual render API, build without STATIC_RENDER_API");
+#else
+        if (m_threadedApi) {
+            return;
+        }
+
+        window->unbind();
+        m_threadedApi = std::make_unique<ThreadedRenderApi>(getApi(), window);
+        m_apiInstance = m_threadedApi.get();
+#endif
+
+    }
+
+    void RenderCommand::stopRenderThread() {
+
+        if (!m_threadedApi) {
+            return;
+        }
+
+#ifndef STATIC_RENDER_API
+        // Destroying it replays what's left, and gives the context back to this thread
+        m_apiInstance = &m_threadedApi->getApi();
+        m_threadedApi.reset();
+#endif
+
+    }
+
+    void RenderCommand::endFrame(const std::shared_ptr<Window>& window) {
+
+        if (m_threadedApi) {
+            m_threadedApi->endFrame();
+        } else {
+            window->swap();
+        }
+
+    }
+
+    void RenderCommand::invoke(const std::function<void()>& function) {
+
+        if (m_threadedApi) {
+            m_threadedApi->invoke(function);
+        } else {
+            function();
+        }
+
+    }
+
+    void RenderCommand::defer(std::function<void()> function) {
+
+        if (m_threadedApi) {
+            m_threadedApi->defer(std::move(function));
+        } else {
+            function();
+        }
+
+    }
+
     void RenderCommand::clear(const glm::vec4& color) {
         getApi().setClearColor(color.r, color.g, color.b, color.a);
         getApi().clear();
@@ -37,6 +112,10 @@ namespace engine {
         getApi().createIndexBuffer(id, data, count);
     }
 
+    void RenderCommand::createIndexBuffer(unsigned int& id, unsigned int count) {
+        getApi().createIndexBuffer(id, count);
+    }
+
     void RenderCommand::bindIndexBuffer(unsigned int& id) {
         getApi().bindIndexBuffer(id);
     }
@@ -46,10 +125,67 @@ namespace engine {
     }
 
 
+    void RenderCommand::createUniformBuffer(unsigned int& id, unsigned int size) {
+        getApi().createUniformBuffer(id, size);
+    }
+
+    void RenderCommand::bindUniformBuffer(unsigned int& id) {
+        getApi().bindUniformBuffer(id);
+    }
+
+    void RenderCommand::bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint) {
+        getApi().bindUniformBufferBase(id, bindingPoint);
+    }
+
+    void RenderCommand::submitUniformBufferData(const void *data, unsigned int size, unsigned int offset) {
+        getApi().submitUniformBufferData(data, size, offset);
+    }
+
+    void RenderCommand::unbindUniformBuffer() {
+        getApi().unbindUniformBuffer();
+    }
+
+    void RenderCommand::createPixelBuffer(unsigned int& id, unsigned int size) {
+        getApi().createPixelBuffer(id, size);
+    }
+
+    void RenderCommand::bindPixelBuffer(unsigned int& id) {
+        getApi().bindPixelBuffer(id);
+    }
+
+    void* RenderCommand::mapPixelBuffer(unsigned int size) {
+        return getApi().mapPixelBuffer(size);
+    }
+
+    bool RenderCommand::unmapPixelBuffer() {
+        return getApi().unmapPixelBuffer();
+    }
+
+    void RenderCommand::unbindPixelBuffer() {
+        getApi().unbindPixelBuffer();
+    }
+
+
     void RenderCommand::deleteBuffer(unsigned int& id) {
         getApi().deleteBuffer(id);
     }
 
+    void RenderCommand::submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset) {
+        getApi().submitBufferData(id, data, size, offset);
+    }
+
+    void* RenderCommand::mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags) {
+        return getApi().mapBuffer(id, offset, size, flags);
+    }
+
+    void RenderCommand::unmapBuffer(unsigned int id) {
+        getApi().unmapBuffer(id);
+    }
+
+    void RenderCommand::copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size) {
+        getApi().copyBufferData(sourceId, destinationId, sourceOffset, destinationOffset, size);
+    }
+
 
     void RenderCommand::createVertexArray(unsigned int& id) {
         getApi().createVertexArray(id);
@@ -72,16 +208,28 @@ namespace engine {
         return (unsigned int) getApi().createShaderProgram();
     }
 
-    unsigned int RenderCommand::compileShader(ShaderType type, const std::string &source) {
-        return (unsigned int) getApi().compileShader(type, source);
-    }
-
     void RenderCommand::attachShader(unsigned int id, unsigned int shaderId) {
         getApi().attachShader(id, shaderId);
     }
 
-    void RenderCommand::compileShaderProgram(unsigned int id) {
-        getApi().compileShaderProgram(id);
+    unsigned int RenderCommand::submitShader(ShaderType type, const std::string& source) {
+        return getApi().submitShader(type, source);
+    }
+
+    bool RenderCommand::checkShader(unsigned int shaderId) {
+        return getApi().checkShader(shaderId);
+    }
+
+    void RenderCommand::submitShaderProgram(unsigned int id) {
+        getApi().submitShaderProgram(id);
+    }
+
+    bool RenderCommand::isShaderProgramReady(unsigned int id) {
+        return getApi().isShaderProgramReady(id);
+    }
+
+    bool RenderCommand::checkShaderProgram(unsigned int id) {
+        return getApi().checkShaderProgram(id);
     }
 
     void RenderCommand::bindShader(unsigned int id) {
@@ -92,6 +240,22 @@ namespace engine {
         getApi().deleteShader(id);
     }
 
+    bool RenderCommand::supportsShaderProgramBinary() {
+        return getApi().supportsShaderProgramBinary();
+    }
+
+    std::string RenderCommand::getDriverSignature() {
+        return getApi().getDriverSignature();
+    }
+
+    void RenderCommand::getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary) {
+        getApi().getShaderProgramBinary(id, format, binary);
+    }
+
+    bool RenderCommand::loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size) {
+        return getApi().loadShaderProgramBinary(id, format, data, size);
+    }
+
 
     int RenderCommand::getUniformLocation(unsigned int id, const std::string& name) {
         return (int) getApi().getUniformLocation(id, name);
@@ -117,16 +281,72 @@ namespace engine {
         getApi().setUniformMat4f(location, value);
     }
 
+    void RenderCommand::getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms) {
+        getApi().getActiveUniforms(id, uniforms);
+    }
+
+    void RenderCommand::setProgramUniform1i(unsigned int id, int location, int value) {
+        getApi().setProgramUniform1i(id, location, value);
+    }
+
+    void RenderCommand::setProgramUniform3f(unsigned int id, int location, const glm::vec3& value) {
+        getApi().setProgramUniform3f(id, location, value);
+    }
+
+    void RenderCommand::setProgramUniform4f(unsigned int id, int location, const glm::vec4& value) {
+        getApi().setProgramUniform4f(id, location, value);
+    }
+
+    void RenderCommand::setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value) {
+        getApi().setProgramUniformMat3f(id, location, value);
+    }
+
+    void RenderCommand::setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value) {
+        getApi().setProgramUniformMat4f(id, location, value);
+    }
+
+    int RenderCommand::getUniformBlockIndex(unsigned int id, const std::string& name) {
+        return (int) getApi().getUniformBlockIndex(id, name);
+    }
+
+    void RenderCommand::setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint) {
+        getApi().setUniformBlockBinding(id, blockIndex, bindingPoint);
+    }
+
     unsigned int RenderCommand::sizeOfLayoutElementType(VertexBufferLayoutElementType type) {
         return getApi().sizeOfVertexBufferLayoutElementType(type);
     }
 
-    void RenderCommand::addVertexArrayAttribute(unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int stride, int offset) {
-        getApi().addVertexArrayAttribute(index, count, type, normalized, stride, offset);
+    void RenderCommand::addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset) {
+        getApi().addVertexArrayAttribute(vertexArrayId, index, count, type, normalized, offset);
+    }
+
+    void RenderCommand::setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride) {
+        getApi().setVertexArrayVertexBuffer(vertexArrayId, bufferId, stride);
+    }
+
+    void RenderCommand::setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId) {
+        getApi().setVertexArrayIndexBuffer(vertexArrayId, bufferId);
+    }
+
+    void RenderCommand::loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data) {
+        getApi().loadTexture(id, width, height, format, data);
+    }
+
+    void RenderCommand::createTexture(unsigned int& id, unsigned int levelCount) {
+        getApi().createTexture(id, levelCount);
+    }
+
+    void RenderCommand::loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size) {
+        getApi().loadTextureLevel(level, format, width, height, data, size);
     }
 
-    void RenderCommand::loadTexture(unsigned int& id, unsigned int width, unsigned int height, void* data) {
-        getApi().loadTexture(id, width, height, data);
+    void RenderCommand::updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data) {
+        getApi().updateTexture(id, format, x, y, width, height, data);
+    }
+
+    void RenderCommand::generateTextureMipmaps(unsigned int id) {
+        getApi().generateTextureMipmaps(id);
     }
 
     void RenderCommand::bindTexture(unsigned int id, unsigned int slot) {
@@ -145,4 +365,28 @@ namespace engine {
         getApi().drawIndexedLines(indexCount);
     }
 
+    void RenderCommand::drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count) {
+        getApi().drawIndexedTrianglesIndirect(commands, count);
+    }
+
+    void* RenderCommand::createFence() {
+        return getApi().createFence();
+    }
+
+    bool RenderCommand::isFenceSignaled(void* fence) {
+        return getApi().isFenceSignaled(fence);
+    }
+
+    void RenderCommand::deleteFence(void* fence) {
+        getApi().deleteFence(fence);
+    }
+
+    void RenderCommand::setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label) {
+        getApi().setDebugLabel(type, id, label);
+    }
+
+    const GpuMemoryTracker& RenderCommand::getMemoryTracker() {
+        return getApi().getMemoryTracker();
+    }
+
 }
\ No newline at end of file
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "RenderApi.h"
+#include "GpuMemoryTracker.h"
 
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 
 namespace engine {
 
+    class OpenGLRenderApi;
+    class ThreadedRenderApi;
+    class Window;
+
     class RenderCommand {
 
     public:
@@ -15,11 +21,31 @@ namespace engine {
         void operator=(RenderCommand const&)  = delete;
 
     private:
-        static RenderApi& m_apiInstance;
-        static RenderApi& getApi() {return m_apiInstance;}
+#ifdef STATIC_RENDER_API
+        // Bound to the backend at compile time, so the calls don't go through the virtual interface
+        static OpenGLRenderApi& getApi();
+#else
+        // Per thread, so that the render thread, if there is one, calls the API it replays on directly
+        static thread_local RenderApi* m_apiInstance;
+        static RenderApi& getApi() {return *m_apiInstance;}
+#endif
+        static std::unique_ptr<ThreadedRenderApi> m_threadedApi;
 
     public:
         static void init();
+
+        // Moves the window's context to a dedicated render thread, which replays the recorded commands one frame behind.
+        // Needs the virtual render API, so it's not available in STATIC_RENDER_API builds
+        static void startRenderThread(const std::shared_ptr<Window>& window);
+        static void stopRenderThread();
+        inline static bool isRenderThreadRunning() {return m_threadedApi != nullptr;}
+        // Presents the frame: hands it over to the render thread if there is one, or swaps the window's buffers
+        static void endFrame(const std::shared_ptr<Window>& window);
+        // Runs a function that uses the context directly, on the thread that owns it
+        static void invoke(const std::function<void()>& function);
+        // The same, but without waiting for it: with a render thread, it runs there when the frame is replayed
+        static void defer(std::function<void()> function);
+
         static void clear(const glm::vec4& color);
 
         static void createVertexBuffer(unsigned int& id, unsigned int size);
@@ -29,10 +55,27 @@ namespace engine {
         static void unbindVertexBuffer();
 
         static void createIndexBuffer(unsigned int& id, unsigned int* data, unsigned int count);
+        static void createIndexBuffer(unsigned int& id, unsigned int count);
         static void bindIndexBuffer(unsigned int&);
         static void unbindIndexBuffer();
 
+        static void createUniformBuffer(unsigned int& id, unsigned int size);
+        static void bindUniformBuffer(unsigned int& id);
+        static void bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint);
+        static void submitUniformBufferData(const void *data, unsigned int size, unsigned int offset);
+        static void unbindUniformBuffer();
+
+        static void createPixelBuffer(unsigned int& id, unsigned int size);
+        static void bindPixelBuffer(unsigned int& id);
+        static void* mapPixelBuffer(unsigned int size);
+        static bool unmapPixelBuffer();
+        static void unbindPixelBuffer();
+
         static void deleteBuffer(unsigned int&);
+        static void submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset);
+        static void* mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags);
+        static void unmapBuffer(unsigned int id);
+        static void copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size);
 
         static void createVertexArray(unsigned int& id);
         static void bindVertexArray(unsigned int& id);
@@ -40,12 +83,20 @@ namespace engine {
         static void deleteVertexArray(unsigned int& id);
 
         static unsigned int createShaderProgram();
-        static unsigned int compileShader(ShaderType type, const std::string& source);
         static void attachShader(unsigned id, unsigned int shaderId);
-        static void compileShaderProgram(unsigned int id);
+        static unsigned int submitShader(ShaderType type, const std::string& source);
+        static bool checkShader(unsigned int shaderId);
+        static void submitShaderProgram(unsigned int id);
+        static bool isShaderProgramReady(unsigned int id);
+        static bool checkShaderProgram(unsigned int id);
         static void bindShader(unsigned int id);
         static void deleteShader(unsigned int id);
 
+        static bool supportsShaderProgramBinary();
+        static std::string getDriverSignature();
+        static void getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary);
+        static bool loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size);
+
         static int getUniformLocation(unsigned int id, const std::string& name);
         static void setUniform1i(int location, int value);
         static void setUniform3f(int location, const glm::vec3& value);
@@ -53,15 +104,39 @@ namespace engine {
         static void setUniformMat3f(int location, const glm::mat3& value);
         static void setUniformMat4f(int location, const glm::mat4& value);
 
-        static unsigned int sizeOfLayoutElementType(VertexBufferLayoutElementType type);
-        static void addVertexArrayAttribute(unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int stride, int offset);
+        static void getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms);
+        static void setProgramUniform1i(unsigned int id, int location, int value);
+        static void setProgramUniform3f(unsigned int id, int location, const glm::vec3& value);
+        static void setProgramUniform4f(unsigned int id, int location, const glm::vec4& value);
+        static void setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value);
+        static void setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value);
+
+        static int getUniformBlockIndex(unsigned int id, const std::string& name);
+        static void setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint);
 
-        static void loadTexture(unsigned int& id, unsigned int width, unsigned int height, void* data);
+        static unsigned int sizeOfLayoutElementType(VertexBufferLayoutElementType type);
+        static void addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset);
+        static void setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride);
+        static void setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId);
+
+        static void loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data);
+        static void createTexture(unsigned int& id, unsigned int levelCount);
+        static void loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size);
+        static void updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data);
+        static void generateTextureMipmaps(unsigned int id);
         static void bindTexture(unsigned int id, unsigned int slot);
         static void deleteTexture(unsigned int& id);
 
         static void drawIndexedTriangles(unsigned int indexCount);
         static void drawIndexedLines(unsigned int indexCount);
+        static void drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count);
+
+        static void* createFence();
+        static bool isFenceSignaled(void* fence);
+        static void deleteFence(void* fence);
+
+        static void setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label);
+        static const GpuMemoryTracker& getMemoryTracker();
 
     };
 
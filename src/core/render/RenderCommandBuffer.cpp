@@ -0,0 +1,310 @@
+#include "RenderCommandBuffer.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace engine {
+
+    template<typename T>
+    static T toValue(const float* floats) {
+        T value;
+        std::memcpy(&value, floats, sizeof(T));
+        return value;
+    }
+
+    void RenderCommandBuffer::record(RenderCommandType type) {
+        Header header = {type, 0, 0};
+        append(&header, sizeof(Header));
+    }
+
+    void RenderCommandBuffer::record(std::function<void()> function) {
+        record(RenderCommandType::RunFunction, RenderCommandArguments{{(unsigned int) m_functions.size(), 0, 0}});
+        m_functions.push_back(std::move(function));
+    }
+
+    void RenderCommandBuffer::execute(RenderApi& api, std::size_t begin, std::size_t end) const {
+
+        std::size_t offset = begin;
+
+        while (offset < end) {
+
+            Header header = read<Header>(offset);
+            std::size_t argumentsOffset = offset + sizeof(Header);
+            const void* payload = m_data.data() + argumentsOffset + header.m_argumentsSize;
+            offset = argumentsOffset + header.m_argumentsSize + header.m_payloadSize;
+
+            switch (header.m_type) {
+
+                case RenderCommandType::SetClearColor: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setClearColor(uniform.m_floats[0], uniform.m_floats[1], uniform.m_floats[2], uniform.m_floats[3]);
+                    break;
+                }
+                case RenderCommandType::Clear:
+                    api.clear();
+                    break;
+
+                case RenderCommandType::BindVertexBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindVertexBuffer(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::SubmitVertexBufferData:
+                    api.submitVertexBufferData(payload, header.m_payloadSize);
+                    break;
+                case RenderCommandType::UnbindVertexBuffer:
+                    api.unbindVertexBuffer();
+                    break;
+
+                case RenderCommandType::BindIndexBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindIndexBuffer(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::UnbindIndexBuffer:
+                    api.unbindIndexBuffer();
+                    break;
+
+                case RenderCommandType::BindUniformBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindUniformBuffer(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::BindUniformBufferBase: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindUniformBufferBase(arguments.m_values[0], arguments.m_values[1]);
+                    break;
+                }
+                case RenderCommandType::SubmitUniformBufferData: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.submitUniformBufferData(payload, header.m_payloadSize, arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::UnbindUniformBuffer:
+                    api.unbindUniformBuffer();
+                    break;
+
+                case RenderCommandType::BindPixelBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindPixelBuffer(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::UnbindPixelBuffer:
+                    api.unbindPixelBuffer();
+                    break;
+
+                case RenderCommandType::DeleteBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.deleteBuffer(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::SubmitBufferData: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.submitBufferData(arguments.m_values[0], payload, header.m_payloadSize, arguments.m_values[1]);
+                    break;
+                }
+                case RenderCommandType::WriteBufferRange: {
+                    // A mapping made on the recording thread, written through a real one now
+                    auto range = read<RenderCommandBufferRange>(argumentsOffset);
+                    void* data = api.mapBuffer(range.m_id, range.m_offset, header.m_payloadSize, range.m_flags);
+                    std::memcpy(data, payload, header.m_payloadSize);
+                    api.unmapBuffer(range.m_id);
+                    break;
+                }
+                case RenderCommandType::CopyBufferData: {
+                    auto copy = read<RenderCommandCopy>(argumentsOffset);
+                    api.copyBufferData(copy.m_sourceId, copy.m_destinationId, copy.m_sourceOffset, copy.m_destinationOffset, copy.m_size);
+                    break;
+                }
+
+                case RenderCommandType::BindVertexArray: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindVertexArray(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::UnbindVertexArray:
+                    api.unbindVertexArray();
+                    break;
+                case RenderCommandType::DeleteVertexArray: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.deleteVertexArray(arguments.m_values[0]);
+                    break;
+                }
+
+                case RenderCommandType::AttachShader: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.attachShader(arguments.m_values[0], arguments.m_values[1]);
+                    break;
+                }
+                case RenderCommandType::DeleteShader: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.deleteShader(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::SubmitShaderProgram: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.submitShaderProgram(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::BindShader: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindShader(arguments.m_values[0]);
+                    break;
+                }
+
+                case RenderCommandType::SetUniform1i: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setUniform1i(uniform.m_location, uniform.m_integer);
+                    break;
+                }
+                case RenderCommandType::SetUniform3f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setUniform3f(uniform.m_location, toValue<glm::vec3>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetUniform4f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setUniform4f(uniform.m_location, toValue<glm::vec4>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetUniformMat3f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setUniformMat3f(uniform.m_location, toValue<glm::mat3>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetUniformMat4f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setUniformMat4f(uniform.m_location, toValue<glm::mat4>(uniform.m_floats));
+                    break;
+                }
+
+                case RenderCommandType::SetProgramUniform1i: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setProgramUniform1i(uniform.m_id, uniform.m_location, uniform.m_integer);
+                    break;
+                }
+                case RenderCommandType::SetProgramUniform3f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setProgramUniform3f(uniform.m_id, uniform.m_location, toValue<glm::vec3>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetProgramUniform4f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setProgramUniform4f(uniform.m_id, uniform.m_location, toValue<glm::vec4>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetProgramUniformMat3f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setProgramUniformMat3f(uniform.m_id, uniform.m_location, toValue<glm::mat3>(uniform.m_floats));
+                    break;
+                }
+                case RenderCommandType::SetProgramUniformMat4f: {
+                    auto uniform = read<RenderCommandUniform>(argumentsOffset);
+                    api.setProgramUniformMat4f(uniform.m_id, uniform.m_location, toValue<glm::mat4>(uniform.m_floats));
+                    break;
+                }
+
+                case RenderCommandType::SetUniformBlockBinding: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.setUniformBlockBinding(arguments.m_values[0], arguments.m_values[1], arguments.m_values[2]);
+                    break;
+                }
+                case RenderCommandType::AddVertexArrayAttribute: {
+                    auto attribute = read<RenderCommandAttribute>(argumentsOffset);
+                    api.addVertexArrayAttribute(attribute.m_vertexArrayId, attribute.m_index, attribute.m_count, attribute.m_type, attribute.m_normalized, attribute.m_offset);
+                    break;
+                }
+                case RenderCommandType::SetVertexArrayVertexBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.setVertexArrayVertexBuffer(arguments.m_values[0], arguments.m_values[1], (int) arguments.m_values[2]);
+                    break;
+                }
+                case RenderCommandType::SetVertexArrayIndexBuffer: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.setVertexArrayIndexBuffer(arguments.m_values[0], arguments.m_values[1]);
+                    break;
+                }
+
+                case RenderCommandType::GenerateTextureMipmaps: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.generateTextureMipmaps(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::BindTexture: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.bindTexture(arguments.m_values[0], arguments.m_values[1]);
+                    break;
+                }
+                case RenderCommandType::DeleteTexture: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.deleteTexture(arguments.m_values[0]);
+                    break;
+                }
+
+                case RenderCommandType::DrawIndexedTriangles: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.drawIndexedTriangles(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::DrawIndexedLines: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    api.drawIndexedLines(arguments.m_values[0]);
+                    break;
+                }
+                case RenderCommandType::DrawIndexedTrianglesIndirect: {
+                    // The payload isn't necessarily aligned for the commands, so copy them out first
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    m_indirectCommands.resize(arguments.m_values[0]);
+                    std::memcpy(m_indirectCommands.data(), payload, header.m_payloadSize);
+                    api.drawIndexedTrianglesIndirect(m_indirectCommands.data(), arguments.m_values[0]);
+                    break;
+                }
+
+                case RenderCommandType::CreateFence: {
+                    auto fence = read<RenderCommandFence>(argumentsOffset);
+                    fence.m_fence->m_fence = api.createFence();
+                    break;
+                }
+                case RenderCommandType::DeleteFence: {
+                    auto fence = read<RenderCommandFence>(argumentsOffset);
+                    if (fence.m_fence->m_fence) {
+                        api.deleteFence(fence.m_fence->m_fence);
+                    }
+                    delete fence.m_fence;
+                    break;
+                }
+
+                case RenderCommandType::RunFunction: {
+                    auto arguments = read<RenderCommandArguments>(argumentsOffset);
+                    m_functions[arguments.m_values[0]]();
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("Unknown render command");
+
+            }
+
+        }
+
+    }
+
+    void RenderCommandBuffer::clear() {
+        // Keeps the capacity, for the next frame
+        m_data.clear();
+        m_functions.clear();
+    }
+
+    void RenderCommandBuffer::append(const void* data, std::size_t size) {
+
+        if (!size) {
+            return;
+        }
+
+        std::size_t offset = m_data.size();
+        m_data.resize(offset + size);
+        std::memcpy(m_data.data() + offset, data, size);
+
+    }
+
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "RenderApi.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+    enum class RenderCommandType {
+        SetClearColor,
+        Clear,
+        BindVertexBuffer,
+        SubmitVertexBufferData,
+        UnbindVertexBuffer,
+        BindIndexBuffer,
+        UnbindIndexBuffer,
+        BindUniformBuffer,
+        BindUniformBufferBase,
+        SubmitUniformBufferData,
+        UnbindUniformBuffer,
+        BindPixelBuffer,
+        UnbindPixelBuffer,
+        DeleteBuffer,
+        SubmitBufferData,
+        WriteBufferRange,
+        CopyBufferData,
+        BindVertexArray,
+        UnbindVertexArray,
+        DeleteVertexArray,
+        AttachShader,
+        DeleteShader,
+        SubmitShaderProgram,
+        BindShader,
+        SetUniform1i,
+        SetUniform3f,
+        SetUniform4f,
+        SetUniformMat3f,
+        SetUniformMat4f,
+        SetProgramUniform1i,
+        SetProgramUniform3f,
+        SetProgramUniform4f,
+        SetProgramUniformMat3f,
+        SetProgramUniformMat4f,
+        SetUniformBlockBinding,
+        AddVertexArrayAttribute,
+        SetVertexArrayVertexBuffer,
+        SetVertexArrayIndexBuffer,
+        GenerateTextureMipmaps,
+        BindTexture,
+        DeleteTexture,
+        DrawIndexedTriangles,
+        DrawIndexedLines,
+        DrawIndexedTrianglesIndirect,
+        CreateFence,
+        DeleteFence,
+        RunFunction
+    };
+
+    // A fence created from a recorded command: the GL sync object only exists once the command is replayed,
+    // and whether it's signaled is polled by the render thread at the end of every frame
+    struct RenderFence {
+        void* m_fence = nullptr;
+        std::atomic<bool> m_signaled{false};
+    };
+
+    // The packets are plain data, so recording one is a copy into the buffer
+    struct RenderCommandArguments {
+        unsigned int m_values[3];
+    };
+
+    struct RenderCommandUniform {
+        unsigned int m_id;
+        int m_location;
+        int m_integer;
+        float m_floats[16];
+    };
+
+    struct RenderCommandAttribute {
+        unsigned int m_vertexArrayId;
+        unsigned int m_index;
+        int m_count;
+        VertexBufferLayoutElementType m_type;
+        bool m_normalized;
+        int m_offset;
+    };
+
+    struct RenderCommandBufferRange {
+        unsigned int m_id;
+        unsigned int m_offset;
+        BufferMapFlags m_flags;
+    };
+
+    struct RenderCommandCopy {
+        unsigned int m_sourceId;
+        unsigned int m_destinationId;
+        unsigned int m_sourceOffset;
+        unsigned int m_destinationOffset;
+        unsigned int m_size;
+    };
+
+    struct RenderCommandFence {
+        RenderFence* m_fence;
+    };
+
+    // A linear buffer of command packets, recorded on one thread and replayed on another. Each packet is a header
+    // followed by its arguments and an optional payload (e.g. buffer data). The buffer is reused from frame to
+    // frame, so it stops allocating once it has grown to fit the biggest frame
+    class RenderCommandBuffer {
+
+    public:
+
+        template<typename T>
+        void record(RenderCommandType type, const T& arguments, const void* payload = nullptr, unsigned int payloadSize = 0) {
+
+            static_assert(std::is_trivially_copyable<T>::value, "Render command arguments must be plain data");
+
+            Header header = {type, (unsigned int) sizeof(T), payloadSize};
+            append(&header, sizeof(Header));
+            append(&arguments, sizeof(T));
+            append(payload, payloadSize);
+
+        }
+
+        void record(RenderCommandType type);
+        // A function to run on the replaying thread, in order with the packets. It isn't plain data, so it's kept
+        // aside until the buffer is cleared, and the packet only holds its index
+        void record(std::function<void()> function);
+
+        // Replays the packets in [begin, end) on the given API
+        void execute(RenderApi& api, std::size_t begin, std::size_t end) const;
+
+        void clear();
+        inline std::size_t getSize() const {return m_data.size();}
+
+    private:
+
+        struct Header {
+            RenderCommandType m_type;
+            unsigned int m_argumentsSize;
+            unsigned int m_payloadSize;
+        };
+
+        std::vector<unsigned char> m_data;
+        std::vector<std::function<void()>> m_functions;
+        mutable std::vector<DrawIndexedCommand> m_indirectCommands; // Reused by every replayed indirect draw, so they don't allocate
+
+        void append(const void* data, std::size_t size);
+
+        template<typename T>
+        T read(std::size_t offset) const {
+            T arguments;
+            std::memcpy(&arguments, m_data.data() + offset, sizeof(T));
+            return arguments;
+        }
+
+    };
+
+}
@@ -2,6 +2,7 @@
 #include "opengl_utils.h"
 
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace engine {
@@ -22,6 +23,16 @@ namespace engine {
             glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
         }
 
+        // Let the driver compile and link shaders on its own threads, when it can
+        m_parallelShaderCompile = GLEW_KHR_parallel_shader_compile;
+        if (m_parallelShaderCompile) {
+            glCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+        }
+
+        // The window asks for a 4.1 context, which is all macOS has, but drivers usually hand out their newest one
+        m_directStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+        m_multiDrawIndirect = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+
         std::cout << "OpenGL Specs:" << std::endl;
         std::cout << "openGL version: " << glGetString(GL_VERSION) << std::endl;
         std::cout << "vendor: " << glGetString(GL_VENDOR) << std::endl;
@@ -39,15 +50,13 @@ namespace engine {
     }
 
     void OpenGLRenderApi::createVertexBuffer(unsigned int& id, unsigned int size) {
-        glCall(glGenBuffers(1, &id));
-        glCall(glBindBuffer(GL_ARRAY_BUFFER, id));
-        glCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+        createBuffer(id, GL_ARRAY_BUFFER, nullptr, size, GL_DYNAMIC_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::VertexBuffer, size);
     }
 
     void OpenGLRenderApi::createVertexBuffer(unsigned int& id, const void *data, unsigned int size) {
-        glCall(glGenBuffers(1, &id));
-        glCall(glBindBuffer(GL_ARRAY_BUFFER, id));
-        glCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+        createBuffer(id, GL_ARRAY_BUFFER, data, size, GL_STATIC_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::VertexBuffer, size);
     }
 
     void OpenGLRenderApi::bindVertexBuffer(unsigned int& id) {
@@ -64,9 +73,13 @@ namespace engine {
     }
 
     void OpenGLRenderApi::createIndexBuffer(unsigned int& id, unsigned int *data, unsigned int count) {
-        glCall(glGenBuffers(1, &id));
-        glCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id));
-        glCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+        createBuffer(id, GL_ELEMENT_ARRAY_BUFFER, data, count * sizeof(unsigned int), GL_STATIC_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::IndexBuffer, count * sizeof(unsigned int));
+    }
+
+    void OpenGLRenderApi::createIndexBuffer(unsigned int& id, unsigned int count) {
+        createBuffer(id, GL_ELEMENT_ARRAY_BUFFER, nullptr, count * sizeof(unsigned int), GL_DYNAMIC_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::IndexBuffer, count * sizeof(unsigned int));
     }
 
     void OpenGLRenderApi::bindIndexBuffer(unsigned int& id) {
@@ -77,12 +90,144 @@ namespace engine {
         glCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
     }
 
+    void OpenGLRenderApi::createUniformBuffer(unsigned int& id, unsigned int size) {
+        createBuffer(id, GL_UNIFORM_BUFFER, nullptr, size, GL_DYNAMIC_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::UniformBuffer, size);
+    }
+
+    void OpenGLRenderApi::bindUniformBuffer(unsigned int& id) {
+        glCall(glBindBuffer(GL_UNIFORM_BUFFER, id));
+    }
+
+    void OpenGLRenderApi::bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint) {
+        glCall(glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, id));
+    }
+
+    void OpenGLRenderApi::submitUniformBufferData(const void *data, unsigned int size, unsigned int offset) {
+        glCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+    }
+
+    void OpenGLRenderApi::unbindUniformBuffer() {
+        glCall(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    }
+
+    void OpenGLRenderApi::createPixelBuffer(unsigned int& id, unsigned int size) {
+
+        createBuffer(id, GL_PIXEL_UNPACK_BUFFER, nullptr, size, GL_STREAM_DRAW);
+        m_memoryTracker.trackBuffer(id, GpuMemoryCategory::PixelBuffer, size);
+
+        // A bound unpack buffer changes how every texture upload reads its data, so never leave it bound
+        if (!m_directStateAccess) {
+            glCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        }
+
+    }
+
+    void OpenGLRenderApi::bindPixelBuffer(unsigned int& id) {
+        glCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id));
+    }
+
+    void* OpenGLRenderApi::mapPixelBuffer(unsigned int size) {
+
+        // Invalidating lets the driver hand out fresh memory instead of waiting for a pending upload from this buffer
+        glCall(void* data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+        if (!data) {
+            throw std::runtime_error("Failed to map pixel buffer");
+        }
+
+        return data;
+
+    }
+
+    bool OpenGLRenderApi::unmapPixelBuffer() {
+        // False when the memory got corrupted while mapped (e.g. by a display mode change)
+        glCall(GLboolean result = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+        return result == GL_TRUE;
+    }
+
+    void OpenGLRenderApi::unbindPixelBuffer() {
+        glCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+    }
+
     void OpenGLRenderApi::deleteBuffer(unsigned int& id) {
+
+        m_memoryTracker.release(GpuResourceType::Buffer, id);
         glCall(glDeleteBuffers(1, &id));
+
+        // The name may be reused by a new buffer, which the attribute pointers would still have to be specified against
+        for (auto& vertexArray : m_vertexArrays) {
+            if (vertexArray.second.m_bufferId == id) {
+                vertexArray.second.m_bufferId = 0;
+            }
+        }
+
+    }
+
+    void OpenGLRenderApi::submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset) {
+
+        if (m_directStateAccess) {
+            glCall(glNamedBufferSubData(id, offset, size, data));
+        } else {
+            // Nothing draws from the copy target, so binding to it doesn't disturb any other binding
+            glCall(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+            glCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
+        }
+
+    }
+
+    void* OpenGLRenderApi::mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags) {
+
+        GLbitfield access = convertBufferMapFlags(flags);
+
+        void* data;
+        if (m_directStateAccess) {
+            glCall(data = glMapNamedBufferRange(id, offset, size, access));
+        } else {
+            glCall(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+            glCall(data = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size, access));
+        }
+
+        if (!data) {
+            throw std::runtime_error("Failed to map buffer");
+        }
+
+        return data;
+
+    }
+
+    void OpenGLRenderApi::unmapBuffer(unsigned int id) {
+
+        if (m_directStateAccess) {
+            glCall(glUnmapNamedBuffer(id));
+        } else {
+            glCall(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+            glCall(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
+        }
+
+    }
+
+    void OpenGLRenderApi::copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size) {
+
+        // Copied on the GPU, without a round trip through the CPU
+        if (m_directStateAccess) {
+            glCall(glCopyNamedBufferSubData(sourceId, destinationId, sourceOffset, destinationOffset, size));
+        } else {
+            glCall(glBindBuffer(GL_COPY_READ_BUFFER, sourceId));
+            glCall(glBindBuffer(GL_COPY_WRITE_BUFFER, destinationId));
+            glCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, destinationOffset, size));
+        }
+
     }
 
     void OpenGLRenderApi::createVertexArray(unsigned int& id) {
-        glCall(glGenVertexArrays(1, &id));
+
+        if (m_directStateAccess) {
+            glCall(glCreateVertexArrays(1, &id));
+        } else {
+            glCall(glGenVertexArrays(1, &id));
+        }
+
     }
 
     void OpenGLRenderApi::bindVertexArray(unsigned int& id) {
@@ -94,6 +239,7 @@ namespace engine {
     }
 
     void OpenGLRenderApi::deleteVertexArray(unsigned int& id) {
+        m_vertexArrays.erase(id);
         glCall(glDeleteVertexArrays(1, &id));
     }
 
@@ -101,27 +247,34 @@ namespace engine {
         return (unsigned int) glCreateProgram();
     }
 
-    unsigned int OpenGLRenderApi::compileShader(ShaderType type, const std::string& source) {
+    unsigned int OpenGLRenderApi::submitShader(ShaderType type, const std::string& source) {
 
+        // Only hand the source to the driver, without waiting for the result
         unsigned int id = glCreateShader(convertShaderType(type));
         const char* src = source.c_str();
         glCall(glShaderSource(id, 1, &src, nullptr));
         glCall(glCompileShader(id));
 
+        return (unsigned int) id;
+
+    }
+
+    bool OpenGLRenderApi::checkShader(unsigned int shaderId) {
+
         int result;
-        glCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
+        glCall(glGetShaderiv(shaderId, GL_COMPILE_STATUS, &result));
         if (result == GL_FALSE) {
-            int length;
-            glCall(glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length));
+            int type, length;
+            glCall(glGetShaderiv(shaderId, GL_SHADER_TYPE, &type));
+            glCall(glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &length));
             char* message = (char*)alloca(length * sizeof(char));
-            glCall(glGetShaderInfoLog(id, length, &length, message));
-            std::cout << "Failed to compile " << (type == ShaderType::Vertex ? "vertex" : "fragment") << " m_shader. Error:" << std::endl;
+            glCall(glGetShaderInfoLog(shaderId, length, &length, message));
+            std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : type == GL_GEOMETRY_SHADER ? "geometry" : "fragment") << " shader. Error:" << std::endl;
             std::cout << message << std::endl;
-            glCall(glDeleteShader(id));
-            return 0;
+            return false;
         }
 
-        return (unsigned int) id;
+        return true;
 
     }
 
@@ -133,13 +286,85 @@ namespace engine {
         glCall(glAttachShader(id, shaderId));
     }
 
-    void OpenGLRenderApi::compileShaderProgram(unsigned int id) {
+    void OpenGLRenderApi::bindShader(unsigned int id) {
+        glCall(glUseProgram(id));
+    }
+
+    void OpenGLRenderApi::submitShaderProgram(unsigned int id) {
+        glCall(glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
         glCall(glLinkProgram(id));
-        glCall(glValidateProgram(id));
     }
 
-    void OpenGLRenderApi::bindShader(unsigned int id) {
-        glCall(glUseProgram(id));
+    bool OpenGLRenderApi::isShaderProgramReady(unsigned int id) {
+
+        // Without KHR_parallel_shader_compile there's no way to ask, and the next status query will simply block
+        if (!m_parallelShaderCompile) {
+            return true;
+        }
+
+        GLint completed = GL_FALSE;
+        glCall(glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &completed));
+        return completed == GL_TRUE;
+
+    }
+
+    bool OpenGLRenderApi::checkShaderProgram(unsigned int id) {
+
+        int result;
+        glCall(glGetProgramiv(id, GL_LINK_STATUS, &result));
+        if (result == GL_FALSE) {
+            int length;
+            glCall(glGetProgramiv(id, GL_INFO_LOG_LENGTH, &length));
+            char* message = (char*)alloca(length * sizeof(char));
+            glCall(glGetProgramInfoLog(id, length, &length, message));
+            std::cout << "Failed to link shader program. Error:" << std::endl;
+            std::cout << message << std::endl;
+            return false;
+        }
+
+        return true;
+
+    }
+
+    bool OpenGLRenderApi::supportsShaderProgramBinary() {
+        GLint formatCount = 0;
+        glCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+        return formatCount > 0;
+    }
+
+    std::string OpenGLRenderApi::getDriverSignature() {
+
+        std::string signature;
+        signature += (const char*) glGetString(GL_VENDOR);
+        signature += "|";
+        signature += (const char*) glGetString(GL_RENDERER);
+        signature += "|";
+        signature += (const char*) glGetString(GL_VERSION);
+
+        return signature;
+
+    }
+
+    void OpenGLRenderApi::getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary) {
+
+        GLint length = 0;
+        glCall(glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length));
+        binary.resize(length);
+
+        GLenum binaryFormat = 0;
+        glCall(glGetProgramBinary(id, length, nullptr, &binaryFormat, binary.data()));
+        format = (unsigned int) binaryFormat;
+
+    }
+
+    bool OpenGLRenderApi::loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size) {
+
+        glCall(glProgramBinary(id, (GLenum) format, data, (GLsizei) size));
+
+        GLint status = GL_FALSE;
+        glCall(glGetProgramiv(id, GL_LINK_STATUS, &status));
+        return status == GL_TRUE;
+
     }
 
     unsigned int OpenGLRenderApi::getUniformLocation(unsigned int id, const std::string& name) {
@@ -166,42 +391,292 @@ namespace engine {
         glCall(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value)));
     }
 
+    void OpenGLRenderApi::getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms) {
+
+        int uniformCount, maxNameLength;
+        glCall(glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &uniformCount));
+        glCall(glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength));
+
+        std::vector<char> nameBuffer(maxNameLength);
+        for (int i = 0; i < uniformCount; i++) {
+
+            GLsizei length;
+            GLint size;
+            GLenum type;
+            glCall(glGetActiveUniform(id, (GLuint) i, maxNameLength, &length, &size, &type, nameBuffer.data()));
+            std::string name(nameBuffer.data(), length);
+
+            // Uniforms inside a block don't have a location, they are set through a uniform buffer
+            int location = glGetUniformLocation(id, name.c_str());
+            if (location < 0) {
+                continue;
+            }
+
+            // Arrays are reported by their first element, "name[0]"
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                name.resize(name.size() - 3);
+            }
+
+            uniforms.push_back({name, location, convertShaderUniformType(type), size});
+
+        }
+
+    }
+
+    void OpenGLRenderApi::setProgramUniform1i(unsigned int id, int location, int value) {
+        glCall(glProgramUniform1i(id, location, value));
+    }
+
+    void OpenGLRenderApi::setProgramUniform3f(unsigned int id, int location, const glm::vec3 &value) {
+        glCall(glProgramUniform3f(id, location, value.x, value.y, value.z));
+    }
+
+    void OpenGLRenderApi::setProgramUniform4f(unsigned int id, int location, const glm::vec4 &value) {
+        glCall(glProgramUniform4f(id, location, value.x, value.y, value.z, value.w));
+    }
+
+    void OpenGLRenderApi::setProgramUniformMat3f(unsigned int id, int location, const glm::mat3 &value) {
+        glCall(glProgramUniformMatrix3fv(id, location, 1, GL_FALSE, glm::value_ptr(value)));
+    }
+
+    void OpenGLRenderApi::setProgramUniformMat4f(unsigned int id, int location, const glm::mat4 &value) {
+        glCall(glProgramUniformMatrix4fv(id, location, 1, GL_FALSE, glm::value_ptr(value)));
+    }
+
+    unsigned int OpenGLRenderApi::getUniformBlockIndex(unsigned int id, const std::string& name) {
+        return (unsigned int) glGetUniformBlockIndex(id, name.c_str());
+    }
+
+    void OpenGLRenderApi::setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint) {
+        glCall(glUniformBlockBinding(id, blockIndex, bindingPoint));
+    }
+
     unsigned int OpenGLRenderApi::sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type) {
-        return sizeof(convertVertexBufferLayoutElementType(type));
+
+        switch (type) {
+            case VertexBufferLayoutElementType::Bool:       return sizeof(GLubyte);
+            case VertexBufferLayoutElementType::Int:        return sizeof(GLint);
+            case VertexBufferLayoutElementType::Float:      return sizeof(GLfloat);
+        }
+
+        throw std::runtime_error("Unknown layout element type");
+
+    }
+
+    void OpenGLRenderApi::addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset) {
+
+        VertexArrayAttribute attribute = {index, count, type, normalized, offset};
+
+        if (m_directStateAccess) {
+
+            // Only the format, every attribute reads from the buffer attached to binding point 0
+            glCall(glEnableVertexArrayAttrib(vertexArrayId, index));
+            if (isIntegerAttribute(attribute)) {
+                glCall(glVertexArrayAttribIFormat(vertexArrayId, index, count, convertVertexBufferLayoutElementType(type), offset));
+            } else {
+                glCall(glVertexArrayAttribFormat(vertexArrayId, index, count, convertVertexBufferLayoutElementType(type), normalized ? GL_TRUE : GL_FALSE, offset));
+            }
+            glCall(glVertexArrayAttribBinding(vertexArrayId, index, 0));
+
+        } else {
+            // Before 4.3 the format can't be set apart from the buffer, so keep it until the buffer is set (again)
+            auto& vertexArray = m_vertexArrays[vertexArrayId];
+            vertexArray.m_attributes.push_back(attribute);
+            vertexArray.m_bufferId = 0;
+        }
+
+    }
+
+    void OpenGLRenderApi::setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride) {
+
+        if (m_directStateAccess) {
+            glCall(glVertexArrayVertexBuffer(vertexArrayId, 0, bufferId, 0, stride));
+            return;
+        }
+
+        // The attribute pointers capture the bound buffer, so they're all set again for a new one, but only then
+        auto& vertexArray = m_vertexArrays[vertexArrayId];
+        if (vertexArray.m_bufferId == bufferId && vertexArray.m_stride == stride) {
+            return;
+        }
+
+        vertexArray.m_bufferId = bufferId;
+        vertexArray.m_stride = stride;
+
+        glCall(glBindVertexArray(vertexArrayId));
+        glCall(glBindBuffer(GL_ARRAY_BUFFER, bufferId));
+
+        for (auto& attribute : vertexArray.m_attributes) {
+
+            glCall(glEnableVertexAttribArray(attribute.m_index));
+
+            const void* pointer = (const void*) (std::size_t) attribute.m_offset;
+            if (isIntegerAttribute(attribute)) {
+                glCall(glVertexAttribIPointer(attribute.m_index, attribute.m_count, convertVertexBufferLayoutElementType(attribute.m_type), stride, pointer));
+            } else {
+                glCall(glVertexAttribPointer(attribute.m_index, attribute.m_count, convertVertexBufferLayoutElementType(attribute.m_type), attribute.m_normalized ? GL_TRUE : GL_FALSE, stride, pointer));
+            }
+
+        }
+
     }
 
-    void OpenGLRenderApi::addVertexArrayAttribute(unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int stride, int offset) {
+    void OpenGLRenderApi::setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId) {
+
+        if (m_directStateAccess) {
+            glCall(glVertexArrayElementBuffer(vertexArrayId, bufferId));
+        } else {
+            // The element buffer binding is part of the vertex array's state
+            glCall(glBindVertexArray(vertexArrayId));
+            glCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId));
+        }
 
-        glCall(glEnableVertexAttribArray(index));
-        glCall(glVertexAttribPointer(
-            index,
-            count,
-            convertVertexBufferLayoutElementType(type),
-                normalized ? GL_TRUE : GL_FALSE,
-            stride,
-            (const void*) offset
-        ));
     }
 
-    void OpenGLRenderApi::loadTexture(unsigned int& id, unsigned int width, unsigned int height, void* data) {
+    void OpenGLRenderApi::loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data) {
+
+        if (m_directStateAccess) {
+
+            // Immutable storage for the whole mip chain up front, filled without binding anything
+            unsigned int levelCount = 1;
+            while ((std::max(width, height) >> levelCount) > 0) {
+                levelCount++;
+            }
 
-        glCall(glGenTextures(1, &id));
-        glCall(glBindTexture(GL_TEXTURE_2D, id));
+            glCall(glCreateTextures(GL_TEXTURE_2D, 1, &id));
+            glCall(glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+            glCall(glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            setTextureSwizzle(id, format);
+            glCall(glTextureStorage2D(id, levelCount, convertTextureFormat(format), width, height));
 
-        glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
-        glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            if (data) {
+                setUnpackAlignment(format, width);
+                glCall(glTextureSubImage2D(id, 0, 0, 0, width, height, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+                glCall(glGenerateTextureMipmap(id));
+            }
 
-        glCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data));
-        glCall(glGenerateMipmap(GL_TEXTURE_2D));
+        } else {
+
+            glCall(glGenTextures(1, &id));
+            glCall(glBindTexture(GL_TEXTURE_2D, id));
+
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            setTextureSwizzle(id, format);
+
+            setUnpackAlignment(format, width);
+            glCall(glTexImage2D(GL_TEXTURE_2D, 0, convertTextureFormat(format), width, height, 0, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+            glCall(glGenerateMipmap(GL_TEXTURE_2D));
+
+        }
+
+        // The full mip chain adds a third on top of the base level
+        std::size_t size = GpuMemoryTracker::getTextureLevelSize(format, width, height);
+        m_memoryTracker.trackTexture(id, format, size + size / 3);
+
+    }
+
+    void OpenGLRenderApi::createTexture(unsigned int& id, unsigned int levelCount) {
+
+        GLint minFilter = levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+
+        if (m_directStateAccess) {
+
+            // The storage is allocated with the first level, once its format and size are known
+            glCall(glCreateTextures(GL_TEXTURE_2D, 1, &id));
+            glCall(glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, minFilter));
+            glCall(glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+
+        } else {
+
+            glCall(glGenTextures(1, &id));
+            glCall(glBindTexture(GL_TEXTURE_2D, id));
+
+            // The levels are uploaded one by one afterwards, so tell GL how many to expect
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
+            glCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1));
+
+        }
+
+        m_createdTexture = id;
+        m_createdTextureLevelCount = levelCount;
+
+    }
+
+    void OpenGLRenderApi::loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size) {
+
+        bool compressed = format == TextureFormat::BC1 || format == TextureFormat::BC3;
+        if (compressed && !GLEW_EXT_texture_compression_s3tc) {
+            throw std::runtime_error("S3TC texture compression is not supported");
+        }
+
+        if (m_directStateAccess) {
+
+            // Levels come largest first, so the first one sizes the storage for all of them
+            if (level == 0) {
+                setTextureSwizzle(m_createdTexture, format);
+                glCall(glTextureStorage2D(m_createdTexture, m_createdTextureLevelCount, convertTextureFormat(format), width, height));
+            }
+
+            if (compressed) {
+                glCall(glCompressedTextureSubImage2D(m_createdTexture, level, 0, 0, width, height, convertTextureFormat(format), size, data));
+            } else {
+                setUnpackAlignment(format, width);
+                glCall(glTextureSubImage2D(m_createdTexture, level, 0, 0, width, height, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+            }
+
+        } else if (compressed) {
+            glCall(glCompressedTexImage2D(GL_TEXTURE_2D, level, convertTextureFormat(format), width, height, 0, size, data));
+        } else {
+            setTextureSwizzle(m_createdTexture, format);
+            setUnpackAlignment(format, width);
+            glCall(glTexImage2D(GL_TEXTURE_2D, level, convertTextureFormat(format), width, height, 0, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+        }
+
+        m_memoryTracker.trackTexture(m_createdTexture, format, GpuMemoryTracker::getTextureLevelSize(format, width, height));
+
+    }
+
+    void OpenGLRenderApi::updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data) {
+
+        // With a pixel buffer bound, data is an offset into it and the copy happens asynchronously
+        setUnpackAlignment(format, width);
+
+        if (m_directStateAccess) {
+            glCall(glTextureSubImage2D(id, 0, x, y, width, height, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+        } else {
+            glCall(glBindTexture(GL_TEXTURE_2D, id));
+            glCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, convertTexturePixelFormat(format), GL_UNSIGNED_BYTE, data));
+        }
+
+    }
+
+    void OpenGLRenderApi::generateTextureMipmaps(unsigned int id) {
+
+        if (m_directStateAccess) {
+            glCall(glGenerateTextureMipmap(id));
+        } else {
+            glCall(glBindTexture(GL_TEXTURE_2D, id));
+            glCall(glGenerateMipmap(GL_TEXTURE_2D));
+        }
 
     }
 
     void OpenGLRenderApi::bindTexture(unsigned int id, unsigned int slot) {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glCall(glBindTexture(GL_TEXTURE_2D, id));
+
+        if (m_directStateAccess) {
+            glCall(glBindTextureUnit(slot, id));
+        } else {
+            glActiveTexture(GL_TEXTURE0 + slot);
+            glCall(glBindTexture(GL_TEXTURE_2D, id));
+        }
+
     }
 
     void OpenGLRenderApi::deleteTexture(unsigned int& id) {
+        m_memoryTracker.release(GpuResourceType::Texture, id);
         glCall(glDeleteTextures(1, &id));
     }
 
@@ -213,11 +688,71 @@ namespace engine {
         glCall(glDrawElements(GL_LINES, indexCount, GL_UNSIGNED_INT, nullptr));
     }
 
+    void OpenGLRenderApi::drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count) {
+
+        if (m_multiDrawIndirect) {
+
+            if (!m_indirectBuffer) {
+                glCall(glGenBuffers(1, &m_indirectBuffer));
+            }
+
+            // Respecified every time, so the driver can orphan the previous commands instead of waiting for them
+            unsigned int size = count * sizeof(DrawIndexedCommand);
+            glCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer));
+            glCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, size, commands, GL_STREAM_DRAW));
+            m_memoryTracker.trackBuffer(m_indirectBuffer, GpuMemoryCategory::IndirectBuffer, size);
+
+            glCall(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, count, 0));
+
+        } else {
+
+            // Same draws, one call each. Instancing isn't used, so the instance fields are ignored
+            for (unsigned int i = 0; i < count; i++) {
+                const DrawIndexedCommand& command = commands[i];
+                glCall(glDrawElementsBaseVertex(GL_TRIANGLES, command.m_indexCount, GL_UNSIGNED_INT, (const void*) (command.m_firstIndex * sizeof(unsigned int)), command.m_baseVertex));
+            }
+
+        }
+
+    }
+
+    void* OpenGLRenderApi::createFence() {
+        glCall(GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        return (void*) fence;
+    }
+
+    bool OpenGLRenderApi::isFenceSignaled(void* fence) {
+
+        // A zero timeout only polls, it never blocks
+        glCall(GLenum result = glClientWaitSync((GLsync) fence, 0, 0));
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+
+    }
+
+    void OpenGLRenderApi::deleteFence(void* fence) {
+        glCall(glDeleteSync((GLsync) fence));
+    }
+
+    void OpenGLRenderApi::setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label) {
+
+        // Names the object in GPU debuggers and driver messages, when the driver supports it
+        if (GLEW_KHR_debug) {
+            glCall(glObjectLabel(convertObjectLabelType(type), id, -1, label.c_str()));
+        }
+
+        m_memoryTracker.setLabel(type, id, label);
+
+    }
+
+    const GpuMemoryTracker& OpenGLRenderApi::getMemoryTracker() {
+        return m_memoryTracker;
+    }
+
 
     GLenum OpenGLRenderApi::convertVertexBufferLayoutElementType(VertexBufferLayoutElementType type) {
 
         switch (type) {
-            case VertexBufferLayoutElementType::Bool:       return GL_BOOL;
+            case VertexBufferLayoutElementType::Bool:       return GL_UNSIGNED_BYTE; // GL_BOOL isn't a vertex attribute type
             case VertexBufferLayoutElementType::Int:        return GL_INT;
             case VertexBufferLayoutElementType::Float:      return GL_FLOAT;
         }
@@ -238,4 +773,141 @@ namespace engine {
 
     }
 
+    ShaderUniformType OpenGLRenderApi::convertShaderUniformType(GLenum type) {
+
+        switch (type) {
+            case GL_INT:            return ShaderUniformType::Int;
+            case GL_FLOAT:          return ShaderUniformType::Float;
+            case GL_FLOAT_VEC2:     return ShaderUniformType::Vec2;
+            case GL_FLOAT_VEC3:     return ShaderUniformType::Vec3;
+            case GL_FLOAT_VEC4:     return ShaderUniformType::Vec4;
+            case GL_FLOAT_MAT3:     return ShaderUniformType::Mat3;
+            case GL_FLOAT_MAT4:     return ShaderUniformType::Mat4;
+            case GL_SAMPLER_2D:     return ShaderUniformType::Sampler2D;
+            default:                return ShaderUniformType::Other;
+        }
+
+    }
+
+    GLenum OpenGLRenderApi::convertTextureFormat(TextureFormat format) {
+
+        switch (format) {
+            case TextureFormat::R8:             return GL_R8;
+            case TextureFormat::RG8:            return GL_RG8;
+            case TextureFormat::A8:             return GL_R8;
+            case TextureFormat::RGB8:           return GL_RGB8;
+            case TextureFormat::RGBA8:          return GL_RGBA8;
+            case TextureFormat::SRGB8:          return GL_SRGB8;
+            case TextureFormat::SRGB8_ALPHA8:   return GL_SRGB8_ALPHA8;
+            case TextureFormat::BC1:            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureFormat::BC3:            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        }
+
+        throw std::runtime_error("Unknown texture format");
+
+    }
+
+    GLenum OpenGLRenderApi::convertTexturePixelFormat(TextureFormat format) {
+
+        switch (format) {
+            case TextureFormat::R8:
+            case TextureFormat::A8:             return GL_RED;
+            case TextureFormat::RG8:            return GL_RG;
+            case TextureFormat::RGB8:
+            case TextureFormat::SRGB8:          return GL_RGB;
+            case TextureFormat::RGBA8:
+            case TextureFormat::SRGB8_ALPHA8:   return GL_RGBA;
+            default:                            throw std::runtime_error("Texture format has no pixel format");
+        }
+
+    }
+
+    GLenum OpenGLRenderApi::convertObjectLabelType(GpuResourceType type) {
+
+        switch (type) {
+            case GpuResourceType::Buffer:       return GL_BUFFER;
+            case GpuResourceType::VertexArray:  return GL_VERTEX_ARRAY;
+            case GpuResourceType::Texture:      return GL_TEXTURE;
+        }
+
+        throw std::runtime_error("Unknown GPU resource type");
+
+    }
+
+    bool OpenGLRenderApi::isIntegerAttribute(const VertexArrayAttribute& attribute) {
+        // Integers reach the shader as integers, unless they're normalized to floats (e.g. 8-bit colors)
+        return attribute.m_type != VertexBufferLayoutElementType::Float && !attribute.m_normalized;
+    }
+
+    GLbitfield OpenGLRenderApi::convertBufferMapFlags(BufferMapFlags flags) {
+
+        // Mappings are only ever written
+        GLbitfield access = GL_MAP_WRITE_BIT;
+        if (hasFlags(flags, BufferMapFlags::InvalidateRange))   access |= GL_MAP_INVALIDATE_RANGE_BIT;
+        if (hasFlags(flags, BufferMapFlags::InvalidateBuffer))  access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+        if (hasFlags(flags, BufferMapFlags::Unsynchronized))    access |= GL_MAP_UNSYNCHRONIZED_BIT;
+
+        return access;
+
+    }
+
+    void OpenGLRenderApi::createBuffer(unsigned int& id, GLenum target, const void* data, unsigned int size, GLenum usage) {
+
+        if (m_directStateAccess) {
+            glCall(glCreateBuffers(1, &id));
+            glCall(glNamedBufferData(id, size, data, usage));
+        } else {
+            glCall(glGenBuffers(1, &id));
+            glCall(glBindBuffer(target, id));
+            glCall(glBufferData(target, size, data, usage));
+        }
+
+    }
+
+    void OpenGLRenderApi::setTextureSwizzle(unsigned int id, TextureFormat format) {
+
+        // Fewer channels in video memory, but shaders still read RGBA from them
+        GLint swizzle[4] = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+        switch (format) {
+            case TextureFormat::R8:
+                swizzle[0] = swizzle[1] = swizzle[2] = GL_RED;
+                swizzle[3] = GL_ONE;
+                break;
+            case TextureFormat::RG8:
+                swizzle[0] = swizzle[1] = swizzle[2] = GL_RED;
+                swizzle[3] = GL_GREEN;
+                break;
+            case TextureFormat::A8:
+                swizzle[0] = swizzle[1] = swizzle[2] = GL_ONE;
+                swizzle[3] = GL_RED;
+                break;
+            default:
+                break;
+        }
+
+        if (m_directStateAccess) {
+            glCall(glTextureParameteriv(id, GL_TEXTURE_SWIZZLE_RGBA, swizzle));
+        } else {
+            glCall(glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle));
+        }
+
+    }
+
+    void OpenGLRenderApi::setUnpackAlignment(TextureFormat format, unsigned int width) {
+
+        unsigned int bytesPerPixel;
+        switch (format) {
+            case TextureFormat::R8:
+            case TextureFormat::A8:             bytesPerPixel = 1; break;
+            case TextureFormat::RG8:            bytesPerPixel = 2; break;
+            case TextureFormat::RGB8:
+            case TextureFormat::SRGB8:          bytesPerPixel = 3; break;
+            default:                            bytesPerPixel = 4; break;
+        }
+
+        // Rows are tightly packed, so only ask for the default 4-byte alignment when every row actually has it
+        glCall(glPixelStorei(GL_UNPACK_ALIGNMENT, (width * bytesPerPixel) % 4 == 0 ? 4 : 1));
+
+    }
+
 }
\ No newline at end of file
@@ -4,19 +4,23 @@
 
 #include "../RenderCommand.h"
 #include "../RenderApi.h"
+#include "../GpuMemoryTracker.h"
 
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace engine {
 
-    class OpenGLRenderApi : public RenderApi {
+    // Final, so that calls through an OpenGLRenderApi reference (STATIC_RENDER_API builds) aren't virtual
+    class OpenGLRenderApi final : public RenderApi {
 
     private:
         OpenGLRenderApi() {};
 
     public:
-        static RenderApi& getInstance(){
+        static OpenGLRenderApi& getInstance(){
             static OpenGLRenderApi m_instance;
             return m_instance;
         }
@@ -37,10 +41,27 @@ namespace engine {
         void unbindVertexBuffer();
 
         void createIndexBuffer(unsigned int& id, unsigned int* data, unsigned int count);
+        void createIndexBuffer(unsigned int& id, unsigned int count);
         void bindIndexBuffer(unsigned int& id);
         void unbindIndexBuffer();
 
+        void createUniformBuffer(unsigned int& id, unsigned int size);
+        void bindUniformBuffer(unsigned int& id);
+        void bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint);
+        void submitUniformBufferData(const void *data, unsigned int size, unsigned int offset);
+        void unbindUniformBuffer();
+
+        void createPixelBuffer(unsigned int& id, unsigned int size);
+        void bindPixelBuffer(unsigned int& id);
+        void* mapPixelBuffer(unsigned int size);
+        bool unmapPixelBuffer();
+        void unbindPixelBuffer();
+
         void deleteBuffer(unsigned int& id);
+        void submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset);
+        void* mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags);
+        void unmapBuffer(unsigned int id);
+        void copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size);
 
         void createVertexArray(unsigned int& id);
         void bindVertexArray(unsigned int& id);
@@ -48,12 +69,20 @@ namespace engine {
         void deleteVertexArray(unsigned int& id);
 
         unsigned int createShaderProgram();
-        unsigned int compileShader(ShaderType type, const std::string& source);
         void attachShader(unsigned id, unsigned int shaderId);
         void deleteShader(unsigned int id);
-        void compileShaderProgram(unsigned int id);
+        unsigned int submitShader(ShaderType type, const std::string& source);
+        bool checkShader(unsigned int shaderId);
+        void submitShaderProgram(unsigned int id);
+        bool isShaderProgramReady(unsigned int id);
+        bool checkShaderProgram(unsigned int id);
         void bindShader(unsigned int id);
 
+        bool supportsShaderProgramBinary();
+        std::string getDriverSignature();
+        void getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary);
+        bool loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size);
+
         unsigned int getUniformLocation(unsigned int id, const std::string& name);
         void setUniform1i(int location, int value);
         void setUniform3f(int location, const glm::vec3& value);
@@ -61,19 +90,76 @@ namespace engine {
         void setUniformMat3f(int location, const glm::mat3& value);
         void setUniformMat4f(int location, const glm::mat4& value);
 
-        unsigned int sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type);
-        void addVertexArrayAttribute(unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int stride, int offset);
+        void getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms);
+        void setProgramUniform1i(unsigned int id, int location, int value);
+        void setProgramUniform3f(unsigned int id, int location, const glm::vec3& value);
+        void setProgramUniform4f(unsigned int id, int location, const glm::vec4& value);
+        void setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value);
+        void setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value);
+
+        unsigned int getUniformBlockIndex(unsigned int id, const std::string& name);
+        void setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint);
 
-        void loadTexture(unsigned int& id, unsigned int width, unsigned int height, void* data);
+        unsigned int sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type);
+        void addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset);
+        void setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride);
+        void setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId);
+
+        void loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data);
+        void createTexture(unsigned int& id, unsigned int levelCount);
+        void loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size);
+        void updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data);
+        void generateTextureMipmaps(unsigned int id);
         void bindTexture(unsigned int id, unsigned int slot);
         void deleteTexture(unsigned int& id);
 
         void drawIndexedTriangles(unsigned int indexCount);
         void drawIndexedLines(unsigned int indexCount);
+        void drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count);
+
+        void* createFence();
+        bool isFenceSignaled(void* fence);
+        void deleteFence(void* fence);
+
+        void setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label);
+        const GpuMemoryTracker& getMemoryTracker();
 
     private:
+        bool m_parallelShaderCompile = false;
+        bool m_directStateAccess = false;   // GL 4.5: edit objects by name, without binding them first
+        bool m_multiDrawIndirect = false;   // GL 4.3: a whole list of draws in one call
+        unsigned int m_indirectBuffer = 0;
+
+        struct VertexArrayAttribute {
+            unsigned int m_index;
+            int m_count;
+            VertexBufferLayoutElementType m_type;
+            bool m_normalized;
+            int m_offset;
+        };
+        struct VertexArrayState {
+            std::vector<VertexArrayAttribute> m_attributes;
+            unsigned int m_bufferId = 0; // What the attribute pointers were last specified against, 0 for nothing yet
+            int m_stride = 0;
+        };
+        std::unordered_map<unsigned int, VertexArrayState> m_vertexArrays; // Without DSA only
+
+        GpuMemoryTracker m_memoryTracker;
+        unsigned int m_createdTexture = 0; // The texture loadTextureLevel uploads to
+        unsigned int m_createdTextureLevelCount = 0;
+
         GLenum convertVertexBufferLayoutElementType(VertexBufferLayoutElementType type);
         GLenum convertShaderType(ShaderType type);
+        ShaderUniformType convertShaderUniformType(GLenum type);
+        GLenum convertTextureFormat(TextureFormat format);
+        GLenum convertTexturePixelFormat(TextureFormat format);
+        GLenum convertObjectLabelType(GpuResourceType type);
+        GLbitfield convertBufferMapFlags(BufferMapFlags flags);
+        bool isIntegerAttribute(const VertexArrayAttribute& attribute);
+
+        void createBuffer(unsigned int& id, GLenum target, const void* data, unsigned int size, GLenum usage);
+        void setTextureSwizzle(unsigned int id, TextureFormat format);
+        void setUnpackAlignment(TextureFormat format, unsigned int width);
 
     };
 
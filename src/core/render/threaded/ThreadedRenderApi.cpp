@@ -0,0 +1,551 @@
+#include "ThreadedRenderApi.h"
+
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace engine {
+
+    ThreadedRenderApi::ThreadedRenderApi(RenderApi& api, const std::shared_ptr<Window>& window)
+        : m_api(api), m_window(window) {
+        m_thread = std::thread(&ThreadedRenderApi::run, this);
+    }
+
+    ThreadedRenderApi::~ThreadedRenderApi() {
+
+        // Whatever was recorded after the last frame still runs, e.g. the final deletions
+        submit(nullptr, false);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+
+        // The context goes back to the thread that created the render thread
+        m_window->bind();
+
+    }
+
+    void ThreadedRenderApi::endFrame() {
+
+        submit(nullptr, true);
+
+        // Stay at most one frame ahead. The other buffer is the previous frame's, so it's free once that frame is done
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() {return m_completedFrameCount + 1 >= m_submittedFrameCount || m_exception;});
+
+            if (m_exception) {
+                std::rethrow_exception(std::exchange(m_exception, nullptr));
+            }
+        }
+
+        m_recordingBuffer = 1 - m_recordingBuffer;
+        getBuffer().clear();
+        m_submittedSize = 0;
+
+    }
+
+    void ThreadedRenderApi::invoke(const std::function<void()>& function) {
+
+        unsigned long submission = submit(&function, false);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this, submission]() {return m_completedCount >= submission || m_exception;});
+
+        // Errors thrown on the render thread surface on the calling thread
+        if (m_exception) {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+
+    }
+
+    void ThreadedRenderApi::defer(std::function<void()> function) {
+        getBuffer().record(std::move(function));
+    }
+
+    void ThreadedRenderApi::init() {
+        invoke([this]() {m_api.init();});
+    }
+
+    void ThreadedRenderApi::setClearColor(float red, float green, float blue, float alpha) {
+        const float color[] = {red, green, blue, alpha};
+        recordUniform(RenderCommandType::SetClearColor, 0, 0, 0, color, 4);
+    }
+
+    void ThreadedRenderApi::clear() {
+        getBuffer().record(RenderCommandType::Clear);
+    }
+
+    void ThreadedRenderApi::createVertexBuffer(unsigned int& id, unsigned int size) {
+        invoke([&]() {m_api.createVertexBuffer(id, size);});
+    }
+
+    void ThreadedRenderApi::createVertexBuffer(unsigned int& id, const void *data, unsigned int size) {
+        invoke([&]() {m_api.createVertexBuffer(id, data, size);});
+    }
+
+    void ThreadedRenderApi::bindVertexBuffer(unsigned int& id) {
+        record(RenderCommandType::BindVertexBuffer, id);
+    }
+
+    void ThreadedRenderApi::submitVertexBufferData(const void *data, unsigned int size) {
+        // The data is copied into the command buffer, so the caller can reuse it right away
+        getBuffer().record(RenderCommandType::SubmitVertexBufferData, RenderCommandArguments{}, data, size);
+    }
+
+    void ThreadedRenderApi::unbindVertexBuffer() {
+        getBuffer().record(RenderCommandType::UnbindVertexBuffer);
+    }
+
+    void ThreadedRenderApi::createIndexBuffer(unsigned int& id, unsigned int* data, unsigned int count) {
+        invoke([&]() {m_api.createIndexBuffer(id, data, count);});
+    }
+
+    void ThreadedRenderApi::createIndexBuffer(unsigned int& id, unsigned int count) {
+        invoke([&]() {m_api.createIndexBuffer(id, count);});
+    }
+
+    void ThreadedRenderApi::bindIndexBuffer(unsigned int& id) {
+        record(RenderCommandType::BindIndexBuffer, id);
+    }
+
+    void ThreadedRenderApi::unbindIndexBuffer() {
+        getBuffer().record(RenderCommandType::UnbindIndexBuffer);
+    }
+
+    void ThreadedRenderApi::createUniformBuffer(unsigned int& id, unsigned int size) {
+        invoke([&]() {m_api.createUniformBuffer(id, size);});
+    }
+
+    void ThreadedRenderApi::bindUniformBuffer(unsigned int& id) {
+        record(RenderCommandType::BindUniformBuffer, id);
+    }
+
+    void ThreadedRenderApi::bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint) {
+        record(RenderCommandType::BindUniformBufferBase, id, bindingPoint);
+    }
+
+    void ThreadedRenderApi::submitUniformBufferData(const void *data, unsigned int size, unsigned int offset) {
+        getBuffer().record(RenderCommandType::SubmitUniformBufferData, RenderCommandArguments{{offset, 0, 0}}, data, size);
+    }
+
+    void ThreadedRenderApi::unbindUniformBuffer() {
+        getBuffer().record(RenderCommandType::UnbindUniformBuffer);
+    }
+
+    void ThreadedRenderApi::createPixelBuffer(unsigned int& id, unsigned int size) {
+        invoke([&]() {m_api.createPixelBuffer(id, size);});
+    }
+
+    void ThreadedRenderApi::bindPixelBuffer(unsigned int& id) {
+        record(RenderCommandType::BindPixelBuffer, id);
+    }
+
+    void* ThreadedRenderApi::mapPixelBuffer(unsigned int size) {
+        // The mapping stays valid until it's unmapped
+        void* data = nullptr;
+        invoke([&]() {data = m_api.mapPixelBuffer(size);});
+        return data;
+    }
+
+    bool ThreadedRenderApi::unmapPixelBuffer() {
+        // Waits, like mapping does, since whether the contents survived is only known on the render thread
+        bool result = false;
+        invoke([&]() {result = m_api.unmapPixelBuffer();});
+        return result;
+    }
+
+    void ThreadedRenderApi::unbindPixelBuffer() {
+        getBuffer().record(RenderCommandType::UnbindPixelBuffer);
+    }
+
+    void ThreadedRenderApi::deleteBuffer(unsigned int& id) {
+        m_mappings.erase(id);
+        record(RenderCommandType::DeleteBuffer, id);
+    }
+
+    void ThreadedRenderApi::submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset) {
+        getBuffer().record(RenderCommandType::SubmitBufferData, RenderCommandArguments{{id, offset, 0}}, data, size);
+    }
+
+    void* ThreadedRenderApi::mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags) {
+
+        // Mapping for real would wait for the render thread, so hand out staging memory instead, which the recorded
+        // unmap copies into the real mapping. The flags still apply there, when the render thread gets to it
+        auto& mapping = m_mappings[id];
+        if (mapping.m_mapped) {
+            throw std::runtime_error("Buffer is already mapped");
+        }
+
+        mapping.m_offset = offset;
+        mapping.m_flags = flags;
+        mapping.m_mapped = true;
+        mapping.m_data.resize(size);
+
+        return mapping.m_data.data();
+
+    }
+
+    void ThreadedRenderApi::unmapBuffer(unsigned int id) {
+
+        auto iterator = m_mappings.find(id);
+        if (iterator == m_mappings.end() || !iterator->second.m_mapped) {
+            throw std::runtime_error("Buffer is not mapped");
+        }
+
+        // The staging memory is kept, for the next time the buffer is mapped
+        auto& mapping = iterator->second;
+        getBuffer().record(RenderCommandType::WriteBufferRange, RenderCommandBufferRange{id, mapping.m_offset, mapping.m_flags}, mapping.m_data.data(), mapping.m_data.size());
+        mapping.m_mapped = false;
+
+    }
+
+    void ThreadedRenderApi::copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size) {
+        getBuffer().record(RenderCommandType::CopyBufferData, RenderCommandCopy{sourceId, destinationId, sourceOffset, destinationOffset, size});
+    }
+
+    void ThreadedRenderApi::createVertexArray(unsigned int& id) {
+        invoke([&]() {m_api.createVertexArray(id);});
+    }
+
+    void ThreadedRenderApi::bindVertexArray(unsigned int& id) {
+        record(RenderCommandType::BindVertexArray, id);
+    }
+
+    void ThreadedRenderApi::unbindVertexArray() {
+        getBuffer().record(RenderCommandType::UnbindVertexArray);
+    }
+
+    void ThreadedRenderApi::deleteVertexArray(unsigned int& id) {
+        record(RenderCommandType::DeleteVertexArray, id);
+    }
+
+    unsigned int ThreadedRenderApi::createShaderProgram() {
+        unsigned int id = 0;
+        invoke([&]() {id = m_api.createShaderProgram();});
+        return id;
+    }
+
+    void ThreadedRenderApi::attachShader(unsigned id, unsigned int shaderId) {
+        record(RenderCommandType::AttachShader, id, shaderId);
+    }
+
+    void ThreadedRenderApi::deleteShader(unsigned int id) {
+        record(RenderCommandType::DeleteShader, id);
+    }
+
+    unsigned int ThreadedRenderApi::submitShader(ShaderType type, const std::string& source) {
+        unsigned int id = 0;
+        invoke([&]() {id = m_api.submitShader(type, source);});
+        return id;
+    }
+
+    bool ThreadedRenderApi::checkShader(unsigned int shaderId) {
+        bool result = false;
+        invoke([&]() {result = m_api.checkShader(shaderId);});
+        return result;
+    }
+
+    void ThreadedRenderApi::submitShaderProgram(unsigned int id) {
+        record(RenderCommandType::SubmitShaderProgram, id);
+    }
+
+    bool ThreadedRenderApi::isShaderProgramReady(unsigned int id) {
+        bool result = false;
+        invoke([&]() {result = m_api.isShaderProgramReady(id);});
+        return result;
+    }
+
+    bool ThreadedRenderApi::checkShaderProgram(unsigned int id) {
+        bool result = false;
+        invoke([&]() {result = m_api.checkShaderProgram(id);});
+        return result;
+    }
+
+    void ThreadedRenderApi::bindShader(unsigned int id) {
+        record(RenderCommandType::BindShader, id);
+    }
+
+    bool ThreadedRenderApi::supportsShaderProgramBinary() {
+        bool result = false;
+        invoke([&]() {result = m_api.supportsShaderProgramBinary();});
+        return result;
+    }
+
+    std::string ThreadedRenderApi::getDriverSignature() {
+        std::string signature;
+        invoke([&]() {signature = m_api.getDriverSignature();});
+        return signature;
+    }
+
+    void ThreadedRenderApi::getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary) {
+        invoke([&]() {m_api.getShaderProgramBinary(id, format, binary);});
+    }
+
+    bool ThreadedRenderApi::loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size) {
+        bool result = false;
+        invoke([&]() {result = m_api.loadShaderProgramBinary(id, format, data, size);});
+        return result;
+    }
+
+    unsigned int ThreadedRenderApi::getUniformLocation(unsigned int id, const std::string& name) {
+        unsigned int location = 0;
+        invoke([&]() {location = m_api.getUniformLocation(id, name);});
+        return location;
+    }
+
+    void ThreadedRenderApi::setUniform1i(int location, int value) {
+        recordUniform(RenderCommandType::SetUniform1i, 0, location, value, nullptr, 0);
+    }
+
+    void ThreadedRenderApi::setUniform3f(int location, const glm::vec3& value) {
+        recordUniform(RenderCommandType::SetUniform3f, 0, location, 0, glm::value_ptr(value), 3);
+    }
+
+    void ThreadedRenderApi::setUniform4f(int location, const glm::vec4& value) {
+        recordUniform(RenderCommandType::SetUniform4f, 0, location, 0, glm::value_ptr(value), 4);
+    }
+
+    void ThreadedRenderApi::setUniformMat3f(int location, const glm::mat3& value) {
+        recordUniform(RenderCommandType::SetUniformMat3f, 0, location, 0, glm::value_ptr(value), 9);
+    }
+
+    void ThreadedRenderApi::setUniformMat4f(int location, const glm::mat4& value) {
+        recordUniform(RenderCommandType::SetUniformMat4f, 0, location, 0, glm::value_ptr(value), 16);
+    }
+
+    void ThreadedRenderApi::getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms) {
+        invoke([&]() {m_api.getActiveUniforms(id, uniforms);});
+    }
+
+    void ThreadedRenderApi::setProgramUniform1i(unsigned int id, int location, int value) {
+        recordUniform(RenderCommandType::SetProgramUniform1i, id, location, value, nullptr, 0);
+    }
+
+    void ThreadedRenderApi::setProgramUniform3f(unsigned int id, int location, const glm::vec3& value) {
+        recordUniform(RenderCommandType::SetProgramUniform3f, id, location, 0, glm::value_ptr(value), 3);
+    }
+
+    void ThreadedRenderApi::setProgramUniform4f(unsigned int id, int location, const glm::vec4& value) {
+        recordUniform(RenderCommandType::SetProgramUniform4f, id, location, 0, glm::value_ptr(value), 4);
+    }
+
+    void ThreadedRenderApi::setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value) {
+        recordUniform(RenderCommandType::SetProgramUniformMat3f, id, location, 0, glm::value_ptr(value), 9);
+    }
+
+    void ThreadedRenderApi::setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value) {
+        recordUniform(RenderCommandType::SetProgramUniformMat4f, id, location, 0, glm::value_ptr(value), 16);
+    }
+
+    unsigned int ThreadedRenderApi::getUniformBlockIndex(unsigned int id, const std::string& name) {
+        unsigned int blockIndex = 0;
+        invoke([&]() {blockIndex = m_api.getUniformBlockIndex(id, name);});
+        return blockIndex;
+    }
+
+    void ThreadedRenderApi::setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint) {
+        record(RenderCommandType::SetUniformBlockBinding, id, blockIndex, bindingPoint);
+    }
+
+    unsigned int ThreadedRenderApi::sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type) {
+        // Doesn't touch the context
+        return m_api.sizeOfVertexBufferLayoutElementType(type);
+    }
+
+    void ThreadedRenderApi::addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset) {
+        getBuffer().record(RenderCommandType::AddVertexArrayAttribute, RenderCommandAttribute{vertexArrayId, index, count, type, normalized, offset});
+    }
+
+    void ThreadedRenderApi::setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride) {
+        record(RenderCommandType::SetVertexArrayVertexBuffer, vertexArrayId, bufferId, (unsigned int) stride);
+    }
+
+    void ThreadedRenderApi::setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId) {
+        record(RenderCommandType::SetVertexArrayIndexBuffer, vertexArrayId, bufferId);
+    }
+
+    void ThreadedRenderApi::loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data) {
+        invoke([&]() {m_api.loadTexture(id, width, height, format, data);});
+    }
+
+    void ThreadedRenderApi::createTexture(unsigned int& id, unsigned int levelCount) {
+        invoke([&]() {m_api.createTexture(id, levelCount);});
+    }
+
+    void ThreadedRenderApi::loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size) {
+        // Texture data is big and the caller owns it, so it isn't copied into the command buffer
+        invoke([&]() {m_api.loadTextureLevel(level, format, width, height, data, size);});
+    }
+
+    void ThreadedRenderApi::updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data) {
+        invoke([&]() {m_api.updateTexture(id, format, x, y, width, height, data);});
+    }
+
+    void ThreadedRenderApi::generateTextureMipmaps(unsigned int id) {
+        record(RenderCommandType::GenerateTextureMipmaps, id);
+    }
+
+    void ThreadedRenderApi::bindTexture(unsigned int id, unsigned int slot) {
+        record(RenderCommandType::BindTexture, id, slot);
+    }
+
+    void ThreadedRenderApi::deleteTexture(unsigned int& id) {
+        record(RenderCommandType::DeleteTexture, id);
+    }
+
+    void ThreadedRenderApi::drawIndexedTriangles(unsigned int indexCount) {
+        record(RenderCommandType::DrawIndexedTriangles, indexCount);
+    }
+
+    void ThreadedRenderApi::drawIndexedLines(unsigned int indexCount) {
+        record(RenderCommandType::DrawIndexedLines, indexCount);
+    }
+
+    void ThreadedRenderApi::drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count) {
+        // The commands are copied, as the payload
+        getBuffer().record(RenderCommandType::DrawIndexedTrianglesIndirect, RenderCommandArguments{{count, 0, 0}}, commands, count * sizeof(DrawIndexedCommand));
+    }
+
+    void* ThreadedRenderApi::createFence() {
+
+        auto fence = new RenderFence();
+        getBuffer().record(RenderCommandType::CreateFence, RenderCommandFence{fence});
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fences.push_back(fence);
+
+        return fence;
+
+    }
+
+    bool ThreadedRenderApi::isFenceSignaled(void* fence) {
+        return ((RenderFence*) fence)->m_signaled;
+    }
+
+    void ThreadedRenderApi::deleteFence(void* fence) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fences.erase(std::remove(m_fences.begin(), m_fences.end(), (RenderFence*) fence), m_fences.end());
+        }
+
+        // Freed by the render thread, once it has replayed everything that uses it
+        getBuffer().record(RenderCommandType::DeleteFence, RenderCommandFence{(RenderFence*) fence});
+
+    }
+
+    void ThreadedRenderApi::setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label) {
+        invoke([&]() {m_api.setDebugLabel(type, id, label);});
+    }
+
+    const GpuMemoryTracker& ThreadedRenderApi::getMemoryTracker() {
+        invoke([this]() {m_memoryTracker = m_api.getMemoryTracker();});
+        return m_memoryTracker;
+    }
+
+    void ThreadedRenderApi::record(RenderCommandType type, unsigned int first, unsigned int second, unsigned int third) {
+        getBuffer().record(type, RenderCommandArguments{{first, second, third}});
+    }
+
+    void ThreadedRenderApi::recordUniform(RenderCommandType type, unsigned int id, int location, int integer, const float* floats, std::size_t floatCount) {
+
+        RenderCommandUniform uniform = {id, location, integer, {}};
+        std::copy(floats, floats + floatCount, uniform.m_floats);
+
+        getBuffer().record(type, uniform);
+
+    }
+
+    unsigned long ThreadedRenderApi::submit(const std::function<void()>* function, bool endOfFrame) {
+
+        unsigned long submission;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_submissions.push_back({&getBuffer(), m_submittedSize, getBuffer().getSize(), function, endOfFrame});
+            submission = ++m_submittedCount;
+
+            if (endOfFrame) {
+                m_submittedFrameCount++;
+            }
+        }
+        m_condition.notify_all();
+
+        m_submittedSize = getBuffer().getSize();
+
+        return submission;
+
+    }
+
+    void ThreadedRenderApi::run() {
+
+        m_window->bind();
+
+        while (true) {
+
+            Submission submission;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() {return !m_running || !m_submissions.empty();});
+
+                if (m_submissions.empty()) {
+                    break;
+                }
+
+                submission = m_submissions.front();
+                m_submissions.pop_front();
+            }
+
+            try {
+
+                submission.m_buffer->execute(m_api, submission.m_begin, submission.m_end);
+
+                if (submission.m_function) {
+                    (*submission.m_function)();
+                }
+
+                if (submission.m_endOfFrame) {
+                    m_window->swap();
+                    pollFences();
+                }
+
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_exception = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_completedCount++;
+                if (submission.m_endOfFrame) {
+                    m_completedFrameCount++;
+                }
+            }
+            m_condition.notify_all();
+
+        }
+
+        m_window->unbind();
+
+    }
+
+    void ThreadedRenderApi::pollFences() {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto fence : m_fences) {
+            if (fence->m_fence && !fence->m_signaled) {
+                fence->m_signaled = m_api.isFenceSignaled(fence->m_fence);
+            }
+        }
+
+    }
+
+}
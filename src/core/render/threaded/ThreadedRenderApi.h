@@ -0,0 +1,188 @@
+#pragma once
+
+#include "../RenderApi.h"
+#include "../RenderCommandBuffer.h"
+#include "../GpuMemoryTracker.h"
+#include "../../window/Window.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Runs another render API on a dedicated render thread, which owns the GL context. The calls that only change
+    // state or draw are recorded into a per-frame command buffer, which the render thread replays one frame behind,
+    // so the main thread can simulate the next frame meanwhile. The calls that return something (creating objects,
+    // queries, mapping) wait for the render thread to catch up and run there, so everything stays in call order
+    class ThreadedRenderApi : public RenderApi {
+
+    public:
+        // The window's context has to be released by the calling thread first, the render thread makes it current
+        ThreadedRenderApi(RenderApi& api, const std::shared_ptr<Window>& window);
+        ~ThreadedRenderApi();
+        ThreadedRenderApi(ThreadedRenderApi const&) = delete;
+        void operator=(ThreadedRenderApi const&) = delete;
+
+        // Hands the recorded frame over to the render thread, which presents it, after waiting for the previous one
+        void endFrame();
+        // Runs a function on the render thread, after everything recorded so far, and waits for it
+        void invoke(const std::function<void()>& function);
+        // Records a function to run on the render thread, after everything recorded so far, without waiting for it
+        void defer(std::function<void()> function);
+        inline RenderApi& getApi() {return m_api;}
+
+        void init();
+
+        void setClearColor(float red, float green, float blue, float alpha);
+        void clear();
+
+        void createVertexBuffer(unsigned int& id, unsigned int size);
+        void createVertexBuffer(unsigned int& id, const void *data, unsigned int size);
+        void bindVertexBuffer(unsigned int& id);
+        void submitVertexBufferData(const void *data, unsigned int size);
+        void unbindVertexBuffer();
+
+        void createIndexBuffer(unsigned int& id, unsigned int* data, unsigned int count);
+        void createIndexBuffer(unsigned int& id, unsigned int count);
+        void bindIndexBuffer(unsigned int& id);
+        void unbindIndexBuffer();
+
+        void createUniformBuffer(unsigned int& id, unsigned int size);
+        void bindUniformBuffer(unsigned int& id);
+        void bindUniformBufferBase(unsigned int& id, unsigned int bindingPoint);
+        void submitUniformBufferData(const void *data, unsigned int size, unsigned int offset);
+        void unbindUniformBuffer();
+
+        void createPixelBuffer(unsigned int& id, unsigned int size);
+        void bindPixelBuffer(unsigned int& id);
+        void* mapPixelBuffer(unsigned int size);
+        bool unmapPixelBuffer();
+        void unbindPixelBuffer();
+
+        void deleteBuffer(unsigned int& id);
+        void submitBufferData(unsigned int id, const void *data, unsigned int size, unsigned int offset);
+        void* mapBuffer(unsigned int id, unsigned int offset, unsigned int size, BufferMapFlags flags);
+        void unmapBuffer(unsigned int id);
+        void copyBufferData(unsigned int sourceId, unsigned int destinationId, unsigned int sourceOffset, unsigned int destinationOffset, unsigned int size);
+
+        void createVertexArray(unsigned int& id);
+        void bindVertexArray(unsigned int& id);
+        void unbindVertexArray();
+        void deleteVertexArray(unsigned int& id);
+
+        unsigned int createShaderProgram();
+        void attachShader(unsigned id, unsigned int shaderId);
+        void deleteShader(unsigned int id);
+        unsigned int submitShader(ShaderType type, const std::string& source);
+        bool checkShader(unsigned int shaderId);
+        void submitShaderProgram(unsigned int id);
+        bool isShaderProgramReady(unsigned int id);
+        bool checkShaderProgram(unsigned int id);
+        void bindShader(unsigned int id);
+
+        bool supportsShaderProgramBinary();
+        std::string getDriverSignature();
+        void getShaderProgramBinary(unsigned int id, unsigned int& format, std::vector<char>& binary);
+        bool loadShaderProgramBinary(unsigned int id, unsigned int format, const void* data, unsigned int size);
+
+        unsigned int getUniformLocation(unsigned int id, const std::string& name);
+        void setUniform1i(int location, int value);
+        void setUniform3f(int location, const glm::vec3& value);
+        void setUniform4f(int location, const glm::vec4& value);
+        void setUniformMat3f(int location, const glm::mat3& value);
+        void setUniformMat4f(int location, const glm::mat4& value);
+
+        void getActiveUniforms(unsigned int id, std::vector<ShaderUniform>& uniforms);
+        void setProgramUniform1i(unsigned int id, int location, int value);
+        void setProgramUniform3f(unsigned int id, int location, const glm::vec3& value);
+        void setProgramUniform4f(unsigned int id, int location, const glm::vec4& value);
+        void setProgramUniformMat3f(unsigned int id, int location, const glm::mat3& value);
+        void setProgramUniformMat4f(unsigned int id, int location, const glm::mat4& value);
+
+        unsigned int getUniformBlockIndex(unsigned int id, const std::string& name);
+        void setUniformBlockBinding(unsigned int id, unsigned int blockIndex, unsigned int bindingPoint);
+
+        unsigned int sizeOfVertexBufferLayoutElementType(VertexBufferLayoutElementType type);
+        void addVertexArrayAttribute(unsigned int vertexArrayId, unsigned int index, int count, VertexBufferLayoutElementType type, bool normalized, int offset);
+        void setVertexArrayVertexBuffer(unsigned int vertexArrayId, unsigned int bufferId, int stride);
+        void setVertexArrayIndexBuffer(unsigned int vertexArrayId, unsigned int bufferId);
+
+        void loadTexture(unsigned int& id, unsigned int width, unsigned int height, TextureFormat format, const void* data);
+        void createTexture(unsigned int& id, unsigned int levelCount);
+        void loadTextureLevel(unsigned int level, TextureFormat format, unsigned int width, unsigned int height, const void* data, unsigned int size);
+        void updateTexture(unsigned int id, TextureFormat format, unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data);
+        void generateTextureMipmaps(unsigned int id);
+        void bindTexture(unsigned int id, unsigned int slot);
+        void deleteTexture(unsigned int& id);
+
+        void drawIndexedTriangles(unsigned int indexCount);
+        void drawIndexedLines(unsigned int indexCount);
+        void drawIndexedTrianglesIndirect(const DrawIndexedCommand* commands, unsigned int count);
+
+        void* createFence();
+        bool isFenceSignaled(void* fence);
+        void deleteFence(void* fence);
+
+        void setDebugLabel(GpuResourceType type, unsigned int id, const std::string& label);
+        const GpuMemoryTracker& getMemoryTracker();
+
+    private:
+
+        // A range of a command buffer to replay, and what to do after it
+        struct Submission {
+            const RenderCommandBuffer* m_buffer;
+            std::size_t m_begin;
+            std::size_t m_end;
+            const std::function<void()>* m_function;
+            bool m_endOfFrame;
+        };
+
+        RenderApi& m_api;
+        std::shared_ptr<Window> m_window;
+
+        // Double buffered: the main thread records one frame while the render thread replays the other
+        RenderCommandBuffer m_buffers[2];
+        unsigned int m_recordingBuffer = 0;
+        std::size_t m_submittedSize = 0; // How much of the recording buffer was handed over already, by invoke
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Submission> m_submissions;
+        unsigned long m_submittedCount = 0;
+        unsigned long m_completedCount = 0;
+        unsigned long m_submittedFrameCount = 0;
+        unsigned long m_completedFrameCount = 0;
+        bool m_running = true;
+        std::exception_ptr m_exception;
+
+        // Staging memory for the mapped buffers, by buffer id
+        struct BufferMapping {
+            unsigned int m_offset = 0;
+            BufferMapFlags m_flags = BufferMapFlags::None;
+            bool m_mapped = false;
+            std::vector<unsigned char> m_data;
+        };
+        std::unordered_map<unsigned int, BufferMapping> m_mappings;
+
+        std::vector<RenderFence*> m_fences;
+        GpuMemoryTracker m_memoryTracker; // A copy, since the render thread keeps changing the API's own
+
+        inline RenderCommandBuffer& getBuffer() {return m_buffers[m_recordingBuffer];}
+        void record(RenderCommandType type, unsigned int first = 0, unsigned int second = 0, unsigned int third = 0);
+        void recordUniform(RenderCommandType type, unsigned int id, int location, int integer, const float* floats, std::size_t floatCount);
+        unsigned long submit(const std::function<void()>* function, bool endOfFrame);
+
+        void run();
+        void pollFences();
+
+    };
+
+}
@@ -0,0 +1,126 @@
+#include "BuddyAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace engine {
+
+    BuddyAllocator::BuddyAllocator(unsigned int size, unsigned int minBlockSize)
+        : m_minBlockSize(minBlockSize), m_maxOrder(0), m_usedSize(0) {
+
+        if (!minBlockSize) {
+            throw std::runtime_error("Buddy allocator blocks can't be empty");
+        }
+
+        while (getOrderSize(m_maxOrder) < size) {
+            m_maxOrder++;
+        }
+
+        clear();
+
+    }
+
+    bool BuddyAllocator::allocate(unsigned int size, unsigned int& offset) {
+
+        unsigned int order = getOrder(size);
+        if (order > m_maxOrder) {
+            return false;
+        }
+
+        // Find the smallest free block that fits
+        unsigned int freeOrder = order;
+        while (freeOrder <= m_maxOrder && m_freeBlocks[freeOrder].empty()) {
+            freeOrder++;
+        }
+
+        if (freeOrder > m_maxOrder) {
+            return false;
+        }
+
+        // Take the lowest one, so allocations stay towards the start
+        auto iterator = m_freeBlocks[freeOrder].begin();
+        offset = *iterator;
+        m_freeBlocks[freeOrder].erase(iterator);
+
+        // Split it down to the size needed, freeing the upper halves
+        while (freeOrder > order) {
+            freeOrder--;
+            m_freeBlocks[freeOrder].insert(offset + getOrderSize(freeOrder));
+        }
+
+        m_allocatedOrders[offset] = order;
+        m_usedSize += getOrderSize(order);
+
+        return true;
+
+    }
+
+    void BuddyAllocator::free(unsigned int offset) {
+
+        auto allocated = m_allocatedOrders.find(offset);
+        if (allocated == m_allocatedOrders.end()) {
+            throw std::runtime_error("Freeing a block that wasn't allocated");
+        }
+
+        unsigned int order = allocated->second;
+        m_allocatedOrders.erase(allocated);
+        m_usedSize -= getOrderSize(order);
+
+        // Merge with the buddy for as long as it's free too
+        while (order < m_maxOrder) {
+
+            // In units of the minimum block, where block offsets are multiples of their size, whatever that unit is
+            unsigned int buddy = (offset / m_minBlockSize ^ (1u << order)) * m_minBlockSize;
+            auto iterator = m_freeBlocks[order].find(buddy);
+            if (iterator == m_freeBlocks[order].end()) {
+                break;
+            }
+
+            m_freeBlocks[order].erase(iterator);
+            offset = std::min(offset, buddy);
+            order++;
+
+        }
+
+        m_freeBlocks[order].insert(offset);
+
+    }
+
+    void BuddyAllocator::clear() {
+
+        m_freeBlocks.assign(m_maxOrder + 1, {});
+        m_freeBlocks[m_maxOrder].insert(0);
+        m_allocatedOrders.clear();
+        m_usedSize = 0;
+
+    }
+
+    unsigned int BuddyAllocator::getLargestFreeBlock() const {
+
+        for (unsigned int order = m_maxOrder + 1; order-- > 0;) {
+            if (!m_freeBlocks[order].empty()) {
+                return getOrderSize(order);
+            }
+        }
+
+        return 0;
+
+    }
+
+    unsigned int BuddyAllocator::getBlockSize(unsigned int size) const {
+        return getOrderSize(getOrder(size));
+    }
+
+    unsigned int BuddyAllocator::getOrder(unsigned int size) const {
+
+        // One past the largest order, if it doesn't fit at all
+        unsigned int order = 0;
+        while (order <= m_maxOrder && getOrderSize(order) < size) {
+            order++;
+        }
+
+        return order;
+
+    }
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Hands out ranges of a space (in any unit: bytes, vertices, indices) as power-of-2 blocks, split in halves
+    // on demand and merged back with their buddy when both are free. Nothing is stored in the space itself, so it
+    // can manage GPU memory. Rounding up wastes up to half a block, but allocating and freeing are O(log size), and
+    // a set of allocations made largest first always packs without gaps
+    class BuddyAllocator {
+
+    public:
+        // The size is rounded up to a power-of-2 number of minimum blocks, which can be any size themselves
+        BuddyAllocator(unsigned int size, unsigned int minBlockSize = 1);
+
+        // Returns false when there's no free block big enough, which may be fragmentation rather than lack of space
+        bool allocate(unsigned int size, unsigned int& offset);
+        void free(unsigned int offset);
+        void clear();
+
+        inline unsigned int getSize() const {return m_minBlockSize << m_maxOrder;}
+        inline unsigned int getUsedSize() const {return m_usedSize;}
+        unsigned int getLargestFreeBlock() const;
+        // The size of the block an allocation of the given size takes up
+        unsigned int getBlockSize(unsigned int size) const;
+
+    private:
+        unsigned int m_minBlockSize;
+        unsigned int m_maxOrder; // The whole space is one block of this order
+        unsigned int m_usedSize;
+
+        std::vector<std::set<unsigned int>> m_freeBlocks; // Offsets of the free blocks, by order
+        std::unordered_map<unsigned int, unsigned int> m_allocatedOrders; // Order of each allocated block, by offset
+
+        unsigned int getOrder(unsigned int size) const;
+        inline unsigned int getOrderSize(unsigned int order) const {return m_minBlockSize << order;}
+
+    };
+
+}
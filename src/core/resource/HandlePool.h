@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+    // Refers to a pool slot by index, and to one particular occupant of it by generation: once the slot is released
+    // (and maybe reused), the generation no longer matches and the handle resolves to nothing
+    template<typename Tag>
+    struct Handle {
+
+        uint32_t m_index = 0;
+        uint32_t m_generation = 0; // Live slots never have generation 0, so a default handle is always stale
+
+        inline bool operator==(const Handle& other) const {return m_index == other.m_index && m_generation == other.m_generation;}
+        inline bool operator!=(const Handle& other) const {return !(*this == other);}
+
+    };
+
+    // For handles as unordered_map keys
+    template<typename Tag>
+    struct HandleHash {
+        inline std::size_t operator()(const Handle<Tag>& handle) const {
+            return std::hash<uint64_t>()(((uint64_t) handle.m_index << 32) | handle.m_generation);
+        }
+    };
+
+    // Slots of values addressed by generational handles, resolved in O(1) without touching any reference count
+    // Not thread-safe: GPU resources are only created and destroyed on the main thread
+    template<typename T, typename Tag = T>
+    class HandlePool {
+
+    public:
+        using HandleType = Handle<Tag>;
+
+        HandleType insert(T value) {
+
+            uint32_t index;
+            if (!m_freeIndices.empty()) {
+                index = m_freeIndices.back();
+                m_freeIndices.pop_back();
+            } else {
+                index = (uint32_t) m_slots.size();
+                m_slots.push_back({T(), 0});
+            }
+
+            Slot& slot = m_slots[index];
+            slot.m_value = std::move(value);
+
+            // Odd generations are live, even ones are free, so a released slot never matches a handle
+            slot.m_generation++;
+
+            return {index, slot.m_generation};
+
+        }
+
+        void release(HandleType handle) {
+
+            if (!isValid(handle)) {
+                return;
+            }
+
+            Slot& slot = m_slots[handle.m_index];
+            slot.m_value = T();
+            slot.m_generation++;
+            m_freeIndices.push_back(handle.m_index);
+
+        }
+
+        inline bool isValid(HandleType handle) const {
+            return handle.m_index < m_slots.size() && m_slots[handle.m_index].m_generation == handle.m_generation && (handle.m_generation & 1u);
+        }
+
+        // Returns nullptr for stale handles
+        inline T* get(HandleType handle) {
+            return isValid(handle) ? &m_slots[handle.m_index].m_value : nullptr;
+        }
+
+        inline unsigned int getSize() const {return m_slots.size() - m_freeIndices.size();}
+
+        // Calls function(handle, value) for every live slot
+        template<typename Function>
+        void forEach(Function function) {
+            for (uint32_t index = 0; index < m_slots.size(); index++) {
+                Slot& slot = m_slots[index];
+                if (slot.m_generation & 1u) {
+                    function(HandleType{index, slot.m_generation}, slot.m_value);
+                }
+            }
+        }
+
+    private:
+
+        struct Slot {
+            T m_value;
+            uint32_t m_generation;
+        };
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_freeIndices;
+
+    };
+
+}
@@ -1,17 +1,22 @@
 #include "RunLoop.h"
 
 #include "../render/RenderCommand.h"
+#include "../render/DeletionQueue.h"
 #include "../imgui/ImGuiRenderApi.h"
 
 namespace engine {
 
-    RunLoop::RunLoop(Application& application)
-        : m_application(application) {
+    RunLoop::RunLoop(Application& application, bool renderThread)
+        : m_application(application), m_renderThread(renderThread) {
 
         RenderCommand::init();
 
         ImGuiRenderApi::init(m_application.getWindow()->getContext());
 
+        if (m_renderThread) {
+            RenderCommand::startRenderThread(m_application.getWindow());
+        }
+
     }
 
     void RunLoop::run() {
@@ -38,11 +43,20 @@ namespace engine {
 
             ImGuiRenderApi::render();
 
-            m_application.getWindow()->swap();
+            // Swaps the buffers, or hands the frame over to the render thread
+            RenderCommand::endFrame(m_application.getWindow());
+
+            // Delete the GL objects released in the frames the GPU has finished with
+            DeletionQueue::getInstance().collect();
+
             m_application.getWindow()->pollEvents();
 
         }
 
+        // The context is about to go, so whatever's still queued is deleted now
+        DeletionQueue::getInstance().flush();
+        RenderCommand::stopRenderThread();
+
         ImGuiRenderApi::shutdown();
         m_application.getWindow()->close();
 
@@ -10,11 +10,13 @@ namespace engine {
     class RunLoop {
 
     public:
-        RunLoop(Application& application);
+        // With a render thread, the GL work of a frame overlaps the simulation of the next one
+        RunLoop(Application& application, bool renderThread = false);
         void run();
 
     private:
         Application& m_application;
+        bool m_renderThread;
 
     };
 
@@ -1,5 +1,7 @@
 #include "BufferLayout.h"
 
+#include <functional>
+
 namespace engine {
 
     BufferLayoutElement::BufferLayoutElement(const std::string& name, unsigned int count, VertexBufferLayoutElementType type, bool normalized)
@@ -10,9 +12,23 @@ namespace engine {
           m_offset(0),
           m_normalized(normalized) {}
 
+    BufferLayoutElement::BufferLayoutElement(const VertexAttribute& attribute)
+        : m_name(attribute.m_name),
+          m_count(attribute.m_count),
+          m_type(attribute.m_type),
+          m_size(attribute.m_count * sizeOfVertexComponent(attribute.m_type)),
+          m_offset(attribute.m_offset),
+          m_normalized(attribute.m_normalized) {}
+
     BufferLayout::BufferLayout(const std::initializer_list<BufferLayoutElement>& elements)
         : m_elements(elements) {
         calculateStrideAndOffsets();
+        calculateHash();
+    }
+
+    BufferLayout::BufferLayout(const VertexAttribute* attributes, std::size_t count, unsigned int stride)
+        : m_elements(attributes, attributes + count), m_stride(stride) {
+        calculateHash();
     }
 
     void BufferLayout::calculateStrideAndOffsets() {
@@ -25,4 +41,40 @@ namespace engine {
         }
     }
 
+    void BufferLayout::calculateHash() {
+
+        // Everything the vertex array setup depends on (the attribute locations are the element indices)
+        auto combine = [this](std::size_t value) {
+            m_hash ^= std::hash<std::size_t>()(value) + 0x9e3779b97f4a7c15 + (m_hash << 6) + (m_hash >> 2);
+        };
+
+        m_hash = 0;
+        combine(m_stride);
+        for (auto& element : m_elements) {
+            combine(element.m_count);
+            combine((std::size_t) element.m_type);
+            combine(element.m_normalized);
+            combine(element.m_offset);
+        }
+
+    }
+
+    bool BufferLayout::isCompatible(BufferLayout& other) {
+
+        if (m_hash != other.m_hash || m_stride != other.m_stride || m_elements.size() != other.m_elements.size()) {
+            return false;
+        }
+
+        for (unsigned int i = 0; i < m_elements.size(); i++) {
+            auto& element = m_elements[i];
+            auto& otherElement = other.m_elements[i];
+            if (element.m_count != otherElement.m_count || element.m_type != otherElement.m_type || element.m_normalized != otherElement.m_normalized || element.m_offset != otherElement.m_offset) {
+                return false;
+            }
+        }
+
+        return true;
+
+    }
+
 }
\ No newline at end of file
@@ -2,12 +2,37 @@
 
 #include "../../core/render/RenderCommand.h"
 
+#include <cstddef>
 #include <string>
 #include <exception>
 #include <vector>
 
 namespace engine {
 
+    // One member of a vertex struct, described at compile time
+    struct VertexAttribute {
+        const char* m_name;
+        unsigned int m_count;
+        VertexBufferLayoutElementType m_type;
+        bool m_normalized;
+        unsigned int m_offset;
+    };
+
+    // The size of one component, as the vertex struct stores it
+    constexpr unsigned int sizeOfVertexComponent(VertexBufferLayoutElementType type) {
+        return type == VertexBufferLayoutElementType::Bool ? sizeof(bool)
+            : type == VertexBufferLayoutElementType::Int ? sizeof(int)
+            : sizeof(float);
+    }
+
+    // Describes a member of a vertex struct, with its component count and offset taken from the struct itself
+    #define VERTEX_ATTRIBUTE(vertex, member, name, type, normalized) \
+        engine::VertexAttribute{name, (unsigned int) (sizeof(vertex::member) / engine::sizeOfVertexComponent(type)), type, normalized, (unsigned int) offsetof(vertex, member)}
+
+    // Specialized next to each vertex struct, with a constexpr array of VertexAttribute named m_attributes
+    template<typename T>
+    struct VertexLayout;
+
     struct BufferLayoutElement {
 
         std::string m_name;
@@ -18,6 +43,7 @@ namespace engine {
         bool m_normalized;
 
         BufferLayoutElement(const std::string& name, unsigned int count, VertexBufferLayoutElementType type, bool normalized = false);
+        BufferLayoutElement(const VertexAttribute& attribute);
 
     };
 
@@ -26,11 +52,45 @@ namespace engine {
     private:
         std::vector<BufferLayoutElement> m_elements;
         unsigned int m_stride;
+        std::size_t m_hash;
+        BufferLayout(const VertexAttribute* attributes, std::size_t count, unsigned int stride);
+        void calculateHash();
     public:
         BufferLayout(const std::initializer_list<BufferLayoutElement>& elements);
         void calculateStrideAndOffsets();
         inline std::vector<BufferLayoutElement>& getElements() {return m_elements;}
         inline unsigned int getStride() {return m_stride;}
+        // Equal for layouts with the same elements (names aside), so vertex arrays can be shared between them
+        inline std::size_t getHash() {return m_hash;}
+        // Whether a vertex array set up for the other layout works for this one too (what the hash is of)
+        bool isCompatible(BufferLayout& other);
+
+        // The layout of a vertex struct, from its VertexLayout specialization: offsets and stride come from the struct,
+        // padding included, instead of being added up from the element sizes
+        template<typename T>
+        static BufferLayout of() {
+
+            constexpr auto& attributes = VertexLayout<T>::m_attributes;
+            static_assert(fitsVertex<T>(), "A vertex attribute lies outside of the vertex struct");
+
+            return BufferLayout(attributes, sizeof(attributes) / sizeof(attributes[0]), sizeof(T));
+
+        }
+
+    private:
+
+        template<typename T>
+        static constexpr bool fitsVertex() {
+
+            for (auto& attribute : VertexLayout<T>::m_attributes) {
+                if (attribute.m_offset + attribute.m_count * sizeOfVertexComponent(attribute.m_type) > sizeof(T)) {
+                    return false;
+                }
+            }
+
+            return true;
+
+        }
 
     };
 
@@ -0,0 +1,180 @@
+#include "GeometryPool.h"
+
+#include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace engine {
+
+    GeometryPool::GeometryPool(BufferLayout& layout, unsigned int vertexCapacity, unsigned int indexCapacity)
+        : m_layout(layout),
+          m_vertexBufferId(0),
+          m_indexBufferId(0),
+          m_vertexAllocator(vertexCapacity),
+          m_indexAllocator(indexCapacity),
+          m_vertexArray(VertexArray::get(layout)) {
+
+        // Sized to the allocators, which round up to a power of 2
+        RenderCommand::createVertexBuffer(m_vertexBufferId, m_vertexAllocator.getSize() * m_layout.getStride());
+        RenderCommand::createIndexBuffer(m_indexBufferId, m_indexAllocator.getSize());
+
+    }
+
+    GeometryPool::~GeometryPool() {
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_vertexBufferId);
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_indexBufferId);
+    }
+
+    GeometryHandle GeometryPool::add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount) {
+
+        GeometryAllocation allocation;
+        allocation.m_vertexCount = vertexCount;
+        allocation.m_indexCount = indexCount;
+
+        if (!allocate(allocation)) {
+
+            // Probably fragmented, so repack first, and only grow whichever buffer still lacks a big enough block
+            unsigned int vertexCapacity = m_vertexAllocator.getSize();
+            unsigned int indexCapacity = m_indexAllocator.getSize();
+            repack(vertexCapacity, indexCapacity);
+
+            while (!allocate(allocation)) {
+
+                if (m_vertexAllocator.getLargestFreeBlock() < m_vertexAllocator.getBlockSize(vertexCount)) {
+                    vertexCapacity *= 2;
+                }
+
+                if (m_indexAllocator.getLargestFreeBlock() < m_indexAllocator.getBlockSize(indexCount)) {
+                    indexCapacity *= 2;
+                }
+
+                repack(vertexCapacity, indexCapacity);
+
+            }
+
+        }
+
+        unsigned int stride = m_layout.getStride();
+        RenderCommand::submitBufferData(m_vertexBufferId, vertices, vertexCount * stride, allocation.m_vertexOffset * stride);
+        RenderCommand::submitBufferData(m_indexBufferId, indices, indexCount * sizeof(unsigned int), allocation.m_indexOffset * sizeof(unsigned int));
+
+        return m_allocations.insert(allocation);
+
+    }
+
+    void GeometryPool::remove(GeometryHandle handle) {
+
+        GeometryAllocation* allocation = m_allocations.get(handle);
+        if (!allocation) {
+            return;
+        }
+
+        // The contents stay until overwritten, so draws already submitted still read them
+        m_vertexAllocator.free(allocation->m_vertexOffset);
+        m_indexAllocator.free(allocation->m_indexOffset);
+        m_allocations.release(handle);
+
+    }
+
+    void GeometryPool::defragment() {
+        repack(m_vertexAllocator.getSize(), m_indexAllocator.getSize());
+    }
+
+    bool GeometryPool::getDrawCommand(GeometryHandle handle, DrawIndexedCommand& command) {
+
+        GeometryAllocation* allocation = m_allocations.get(handle);
+        if (!allocation) {
+            return false;
+        }
+
+        command = {allocation->m_indexCount, 1, allocation->m_indexOffset, (int) allocation->m_vertexOffset, 0};
+        return true;
+
+    }
+
+    void GeometryPool::bind() {
+        m_vertexArray->setBuffers(m_vertexBufferId, m_indexBufferId);
+        m_vertexArray->bind();
+    }
+
+    bool GeometryPool::allocate(GeometryAllocation& allocation) {
+
+        if (!m_vertexAllocator.allocate(allocation.m_vertexCount, allocation.m_vertexOffset)) {
+            return false;
+        }
+
+        // Both or neither
+        if (!m_indexAllocator.allocate(allocation.m_indexCount, allocation.m_indexOffset)) {
+            m_vertexAllocator.free(allocation.m_vertexOffset);
+            return false;
+        }
+
+        return true;
+
+    }
+
+    void GeometryPool::repack(unsigned int vertexCapacity, unsigned int indexCapacity) {
+
+        // Copied into new buffers rather than moved within the old ones, so no copy overlaps another, and draws
+        // already submitted keep reading the old ones until the deletion queue releases them
+        BuddyAllocator vertexAllocator(vertexCapacity);
+        BuddyAllocator indexAllocator(indexCapacity);
+
+        unsigned int vertexBufferId = 0;
+        unsigned int indexBufferId = 0;
+        RenderCommand::createVertexBuffer(vertexBufferId, vertexAllocator.getSize() * m_layout.getStride());
+        RenderCommand::createIndexBuffer(indexBufferId, indexAllocator.getSize());
+
+        std::vector<GeometryAllocation*> allocations;
+        m_allocations.forEach([&](GeometryHandle, GeometryAllocation& allocation) {
+            allocations.push_back(&allocation);
+        });
+
+        // Buddy blocks allocated largest first leave no gaps between them
+        std::sort(allocations.begin(), allocations.end(), [](GeometryAllocation* left, GeometryAllocation* right) {
+            return left->m_vertexCount > right->m_vertexCount;
+        });
+
+        unsigned int stride = m_layout.getStride();
+        for (auto* allocation : allocations) {
+
+            unsigned int offset;
+            if (!vertexAllocator.allocate(allocation->m_vertexCount, offset)) {
+                throw std::runtime_error("Geometry pool vertices don't fit after repacking");
+            }
+
+            RenderCommand::copyBufferData(m_vertexBufferId, vertexBufferId, allocation->m_vertexOffset * stride, offset * stride, allocation->m_vertexCount * stride);
+            allocation->m_vertexOffset = offset;
+
+        }
+
+        std::sort(allocations.begin(), allocations.end(), [](GeometryAllocation* left, GeometryAllocation* right) {
+            return left->m_indexCount > right->m_indexCount;
+        });
+
+        for (auto* allocation : allocations) {
+
+            unsigned int offset;
+            if (!indexAllocator.allocate(allocation->m_indexCount, offset)) {
+                throw std::runtime_error("Geometry pool indices don't fit after repacking");
+            }
+
+            RenderCommand::copyBufferData(m_indexBufferId, indexBufferId, allocation->m_indexOffset * sizeof(unsigned int), offset * sizeof(unsigned int), allocation->m_indexCount * sizeof(unsigned int));
+            allocation->m_indexOffset = offset;
+
+        }
+
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_vertexBufferId);
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_indexBufferId);
+
+        m_vertexBufferId = vertexBufferId;
+        m_indexBufferId = indexBufferId;
+        m_vertexAllocator = std::move(vertexAllocator);
+        m_indexAllocator = std::move(indexAllocator);
+
+    }
+
+}
\ No newline at end of file
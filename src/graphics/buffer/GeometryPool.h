@@ -0,0 +1,62 @@
+#pragma once
+
+#include "BufferLayout.h"
+#include "VertexArray.h"
+#include "../../core/resource/BuddyAllocator.h"
+#include "../../core/resource/HandlePool.h"
+
+#include <memory>
+
+namespace engine {
+
+    // Where a mesh lives in a geometry pool, in vertices and indices (not bytes)
+    struct GeometryAllocation {
+        unsigned int m_vertexOffset = 0;
+        unsigned int m_vertexCount = 0;
+        unsigned int m_indexOffset = 0;
+        unsigned int m_indexCount = 0;
+    };
+
+    using GeometryHandle = Handle<GeometryAllocation>;
+
+    // Packs the vertices and indices of many static meshes, of one vertex layout, into a single vertex buffer and a
+    // single index buffer, so they all draw through one vertex array, each at its own base vertex and first index
+    // (and a whole list of them in one multi-draw). When an added mesh doesn't fit, which after removing meshes is
+    // usually fragmentation, everything is repacked from the start, on the GPU, and the buffers only grow if that
+    // isn't enough. Handles stay valid across repacks
+    class GeometryPool {
+
+    private:
+        BufferLayout m_layout;
+        unsigned int m_vertexBufferId;
+        unsigned int m_indexBufferId;
+        BuddyAllocator m_vertexAllocator;
+        BuddyAllocator m_indexAllocator;
+        HandlePool<GeometryAllocation> m_allocations;
+        std::shared_ptr<VertexArray> m_vertexArray;
+    public:
+        GeometryPool(BufferLayout& layout, unsigned int vertexCapacity, unsigned int indexCapacity);
+        ~GeometryPool();
+        GeometryPool(GeometryPool const&) = delete;
+        void operator=(GeometryPool const&) = delete;
+        // The vertices are in the layout, and the indices relative to the mesh's first vertex
+        GeometryHandle add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+        void remove(GeometryHandle handle);
+        // Moves every mesh towards the start of the buffers, largest first, so the free space is in one piece again
+        void defragment();
+        // Returns false for stale handles
+        bool getDrawCommand(GeometryHandle handle, DrawIndexedCommand& command);
+        // Attaches the buffers to the vertex array shared by the layout, and binds it
+        void bind();
+        // Returns nullptr for stale handles
+        inline const GeometryAllocation* get(GeometryHandle handle) {return m_allocations.get(handle);}
+        inline unsigned int getMeshCount() {return m_allocations.getSize();}
+        inline unsigned int getVertexCapacity() {return m_vertexAllocator.getSize();}
+        inline unsigned int getIndexCapacity() {return m_indexAllocator.getSize();}
+
+    private:
+        bool allocate(GeometryAllocation& allocation);
+        void repack(unsigned int vertexCapacity, unsigned int indexCapacity);
+    };
+
+}
\ No newline at end of file
@@ -1,16 +1,63 @@
 #include "IndexBuffer.h"
 
 #include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+
+#include <stdexcept>
 
 namespace engine {
 
     IndexBuffer::IndexBuffer(unsigned int* data, unsigned int count)
-        : m_count(count), m_rendererId(0) {
+        : m_count(count), m_rendererId(0), m_dynamic(false), m_mapped(false) {
         RenderCommand::createIndexBuffer(m_rendererId, data, count);
     }
 
+    IndexBuffer::IndexBuffer(unsigned int count)
+        : m_count(count), m_rendererId(0), m_dynamic(true), m_mapped(false) {
+        RenderCommand::createIndexBuffer(m_rendererId, count);
+    }
+
     IndexBuffer::~IndexBuffer() {
-        RenderCommand::deleteBuffer(m_rendererId);
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_rendererId);
+    }
+
+    void IndexBuffer::setData(const unsigned int* data, unsigned int count, unsigned int offset) {
+
+        if (!m_dynamic) {
+            throw std::runtime_error("Can't set data for non-dynamic index buffer");
+        }
+
+        if (offset + count > m_count) {
+            throw std::runtime_error("Index buffer data out of range");
+        }
+
+        RenderCommand::submitBufferData(m_rendererId, data, count * sizeof(unsigned int), offset * sizeof(unsigned int));
+    }
+
+    unsigned int* IndexBuffer::map(unsigned int offset, unsigned int count, BufferMapFlags flags) {
+
+        if (!m_dynamic) {
+            throw std::runtime_error("Can't map non-dynamic index buffer");
+        }
+
+        if (offset + count > m_count) {
+            throw std::runtime_error("Index buffer data out of range");
+        }
+
+        if (m_mapped) {
+            throw std::runtime_error("Index buffer is already mapped");
+        }
+
+        void* data = RenderCommand::mapBuffer(m_rendererId, offset * sizeof(unsigned int), count * sizeof(unsigned int), flags);
+        m_mapped = true;
+
+        return (unsigned int*) data;
+
+    }
+
+    void IndexBuffer::unmap() {
+        RenderCommand::unmapBuffer(m_rendererId);
+        m_mapped = false;
     }
 
     void IndexBuffer::bind() {
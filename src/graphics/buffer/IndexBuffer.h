@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../core/render/RenderApi.h"
+
 namespace engine {
 
     class IndexBuffer {
@@ -7,12 +9,23 @@ namespace engine {
     private:
         unsigned int m_rendererId;
         unsigned int m_count;
+        bool m_dynamic;
+        bool m_mapped;
     public:
         IndexBuffer(unsigned int* data, unsigned int count);
+        // Dynamic, filled afterwards with setData or map
+        IndexBuffer(unsigned int count);
         ~IndexBuffer();
+        // Overwrites count indices, starting at offset (in indices)
+        void setData(const unsigned int* data, unsigned int count, unsigned int offset = 0);
+        // Maps a range of indices for writing, until unmap()
+        unsigned int* map(unsigned int offset, unsigned int count, BufferMapFlags flags = BufferMapFlags::InvalidateRange);
+        void unmap();
         void bind();
         void unbind();
         inline unsigned int getCount() {return m_count;}
+        inline unsigned int getRendererId() {return m_rendererId;}
+        inline bool isMapped() {return m_mapped;}
     };
 
 }
\ No newline at end of file
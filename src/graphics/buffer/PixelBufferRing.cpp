@@ -0,0 +1,62 @@
+#include "PixelBufferRing.h"
+
+#include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+
+#include <stdexcept>
+
+namespace engine {
+
+    PixelBufferRing::PixelBufferRing(unsigned int size, unsigned int count)
+        : m_rendererIds(count, 0), m_size(size), m_current(0), m_mapped(false) {
+
+        for (auto& rendererId : m_rendererIds) {
+            RenderCommand::createPixelBuffer(rendererId, size);
+        }
+
+    }
+
+    PixelBufferRing::~PixelBufferRing() {
+        for (auto& rendererId : m_rendererIds) {
+            DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, rendererId);
+        }
+    }
+
+    void* PixelBufferRing::map(unsigned int size) {
+
+        if (size > m_size) {
+            throw std::runtime_error("Pixel buffer data out of range");
+        }
+
+        if (m_mapped) {
+            throw std::runtime_error("Pixel buffer is already mapped");
+        }
+
+        m_current = (m_current + 1) % m_rendererIds.size();
+
+        // The mapping outlives the binding, and a bound unpack buffer would turn every other texture upload's data
+        // pointer into an offset into it, so it's only bound again to unmap it
+        RenderCommand::bindPixelBuffer(m_rendererIds[m_current]);
+        void* data = RenderCommand::mapPixelBuffer(size);
+        RenderCommand::unbindPixelBuffer();
+        m_mapped = true;
+
+        return data;
+
+    }
+
+    bool PixelBufferRing::unmap() {
+
+        RenderCommand::bindPixelBuffer(m_rendererIds[m_current]);
+        bool result = RenderCommand::unmapPixelBuffer();
+        m_mapped = false;
+
+        return result;
+
+    }
+
+    void PixelBufferRing::unbind() {
+        RenderCommand::unbindPixelBuffer();
+    }
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+namespace engine {
+
+    // A few pixel buffers used in turn, so the CPU fills one while the GPU is still copying from the previous ones
+    class PixelBufferRing {
+
+    private:
+        std::vector<unsigned int> m_rendererIds;
+        unsigned int m_size;
+        unsigned int m_current;
+        bool m_mapped;
+    public:
+        PixelBufferRing(unsigned int size, unsigned int count = 3);
+        ~PixelBufferRing();
+        // Moves on to the next buffer, and maps it for writing. It's only bound while mapping
+        void* map(unsigned int size);
+        // Binds the buffer again, for the upload from it, until unbind(). Returns false if the contents were lost
+        bool unmap();
+        void unbind();
+        inline unsigned int getSize() {return m_size;}
+        inline bool isMapped() {return m_mapped;}
+    };
+
+}
@@ -0,0 +1,65 @@
+#include "StreamingBuffer.h"
+
+#include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+
+    StreamingBuffer::StreamingBuffer(unsigned int size)
+        : m_rendererId(0), m_size(size), m_head(0), m_mapped(false) {
+        RenderCommand::createVertexBuffer(m_rendererId, size);
+    }
+
+    StreamingBuffer::~StreamingBuffer() {
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_rendererId);
+    }
+
+    StreamingAllocation StreamingBuffer::allocate(unsigned int size, unsigned int alignment) {
+
+        if (size > m_size) {
+            throw std::runtime_error("Streaming buffer allocation too big");
+        }
+
+        if (m_mapped) {
+            throw std::runtime_error("Streaming buffer is already mapped");
+        }
+
+        unsigned int offset = (m_head + alignment - 1) / alignment * alignment;
+
+        BufferMapFlags flags;
+        if (offset + size <= m_size) {
+            // Nothing has been written to this range since the buffer was last orphaned, so no need to wait
+            flags = BufferMapFlags::InvalidateRange | BufferMapFlags::Unsynchronized;
+        } else {
+            // Start over, on fresh memory
+            offset = 0;
+            flags = BufferMapFlags::InvalidateBuffer;
+        }
+
+        void* data = RenderCommand::mapBuffer(m_rendererId, offset, size, flags);
+        m_head = offset + size;
+        m_mapped = true;
+
+        return {data, offset};
+
+    }
+
+    void StreamingBuffer::commit() {
+        RenderCommand::unmapBuffer(m_rendererId);
+        m_mapped = false;
+    }
+
+    unsigned int StreamingBuffer::write(const void* data, unsigned int size, unsigned int alignment) {
+
+        StreamingAllocation allocation = allocate(size, alignment);
+        std::memcpy(allocation.m_data, data, size);
+        commit();
+
+        return allocation.m_offset;
+
+    }
+
+}
\ No newline at end of file
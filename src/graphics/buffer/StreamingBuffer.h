@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../../core/render/RenderApi.h"
+
+namespace engine {
+
+    struct StreamingAllocation {
+        void* m_data; // Mapped, writable until the next commit()
+        unsigned int m_offset; // In bytes, from the start of the buffer
+    };
+
+    // A buffer for data that is written once and drawn soon after (batched vertices, particles, debug lines), so it
+    // doesn't need a buffer of its own. Allocations are bumped through it and mapped unsynchronized, since nothing the
+    // GPU could still be reading lies ahead of the head. When the end is reached, the whole buffer is orphaned and
+    // the head starts over, so pending draws keep the old contents (which is also why data drawn together should go
+    // in one allocation). Since the buffer is just memory, one can hold vertices and indices alike
+    class StreamingBuffer {
+
+    private:
+        unsigned int m_rendererId;
+        unsigned int m_size;
+        unsigned int m_head;
+        bool m_mapped;
+    public:
+        StreamingBuffer(unsigned int size);
+        ~StreamingBuffer();
+        StreamingBuffer(StreamingBuffer const&) = delete;
+        void operator=(StreamingBuffer const&) = delete;
+        // Reserves size bytes at a multiple of alignment (which doesn't need to be a power of 2, so a vertex size
+        // works, and the offset divided by it is a base vertex), and maps them to be written in place
+        StreamingAllocation allocate(unsigned int size, unsigned int alignment = 4);
+        // Unmaps the last allocation, before anything draws from it
+        void commit();
+        // Allocates, copies the data in, and commits. Returns the offset of the data
+        unsigned int write(const void* data, unsigned int size, unsigned int alignment = 4);
+        inline unsigned int getRendererId() {return m_rendererId;}
+        inline unsigned int getSize() {return m_size;}
+        inline bool isMapped() {return m_mapped;}
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "UniformBuffer.h"
+
+#include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+
+#include <stdexcept>
+
+namespace engine {
+
+    UniformBuffer::UniformBuffer(unsigned int size, unsigned int bindingPoint)
+        : m_rendererId(0), m_size(size), m_bindingPoint(bindingPoint) {
+
+        RenderCommand::createUniformBuffer(m_rendererId, size);
+
+        // The buffer stays attached to its binding point, so any shader whose block points there can read it
+        RenderCommand::bindUniformBufferBase(m_rendererId, m_bindingPoint);
+
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_rendererId);
+    }
+
+    void UniformBuffer::setData(const void *data, unsigned int size, unsigned int offset) {
+
+        if (offset + size > m_size) {
+            throw std::runtime_error("Uniform buffer data out of range");
+        }
+
+        RenderCommand::submitBufferData(m_rendererId, data, size, offset);
+    }
+
+    void UniformBuffer::bind() {
+        RenderCommand::bindUniformBuffer(m_rendererId);
+    }
+
+    void UniformBuffer::unbind() {
+        RenderCommand::unbindUniformBuffer();
+    }
+
+}
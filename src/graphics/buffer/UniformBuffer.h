@@ -0,0 +1,21 @@
+#pragma once
+
+namespace engine {
+
+    class UniformBuffer {
+
+    private:
+        unsigned int m_rendererId;
+        unsigned int m_size;
+        unsigned int m_bindingPoint;
+    public:
+        UniformBuffer(unsigned int size, unsigned int bindingPoint);
+        ~UniformBuffer();
+        void setData(const void* data, unsigned int size, unsigned int offset = 0);
+        void bind();
+        void unbind();
+        inline unsigned int getSize() {return m_size;}
+        inline unsigned int getBindingPoint() {return m_bindingPoint;}
+    };
+
+}
@@ -1,13 +1,20 @@
 #include "VertexArray.h"
 
+#include "../../core/render/DeletionQueue.h"
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
 namespace engine {
 
-    VertexArray::VertexArray() {
+    VertexArray::VertexArray()
+        : m_rendererId(0), m_stride(0) {
         RenderCommand::createVertexArray(m_rendererId);
         RenderCommand::unbindVertexArray();
     }
     VertexArray::~VertexArray() {
-        RenderCommand::deleteVertexArray(m_rendererId);
+        DeletionQueue::getInstance().enqueue(GpuResourceType::VertexArray, m_rendererId);
     }
 
     void VertexArray::bind() {
@@ -19,25 +26,54 @@ namespace engine {
     }
 
     void VertexArray::addBuffer(std::shared_ptr<VertexBuffer> vertexBuffer, std::shared_ptr<IndexBuffer> indexBuffer) {
+        setLayout(vertexBuffer->getBufferLayout());
+        setBuffers(vertexBuffer->getRendererId(), indexBuffer->getRendererId());
+        m_indexBuffer = std::move(indexBuffer);
+    }
 
-        bind();
+    void VertexArray::setLayout(BufferLayout& layout) {
 
-        vertexBuffer->bind();
-        auto& elements = vertexBuffer->getBufferLayout().getElements();
+        // Set up by name, so whatever vertex array is bound stays bound
+        auto& elements = layout.getElements();
         for (unsigned int i = 0; i < elements.size(); i++) {
             auto& element = elements[i];
             RenderCommand::addVertexArrayAttribute(
+                    m_rendererId,
                     i,
                     element.m_count,
                     element.m_type,
                     element.m_normalized,
-                    vertexBuffer->getBufferLayout().getStride(),
                     element.m_offset
                 );
         }
 
-        indexBuffer->bind();
-        m_indexBuffer = std::move(indexBuffer);
+        m_stride = layout.getStride();
+
+    }
+
+    void VertexArray::setBuffers(unsigned int vertexBufferId, unsigned int indexBufferId) {
+        RenderCommand::setVertexArrayVertexBuffer(m_rendererId, vertexBufferId, m_stride);
+        RenderCommand::setVertexArrayIndexBuffer(m_rendererId, indexBufferId);
+    }
+
+    const std::shared_ptr<VertexArray>& VertexArray::get(BufferLayout& layout) {
+
+        // Never destroyed, like the renderer's storage, so nothing is enqueued for deletion after the deletion queue is gone
+        // Keyed by hash, with the layouts kept to tell apart the ones that only collide (in lists, so references stay valid)
+        static auto* cache = new std::unordered_map<std::size_t, std::list<std::pair<BufferLayout, std::shared_ptr<VertexArray>>>>();
+
+        auto& entries = (*cache)[layout.getHash()];
+        for (auto& entry : entries) {
+            if (entry.first.isCompatible(layout)) {
+                return entry.second;
+            }
+        }
+
+        auto vertexArray = std::make_shared<VertexArray>();
+        vertexArray->setLayout(layout);
+        entries.emplace_back(layout, std::move(vertexArray));
+
+        return entries.back().second;
 
     }
 
@@ -3,11 +3,14 @@
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
 
+#include <cstddef>
+
 namespace engine {
 
     class VertexArray {
     private:
         unsigned int m_rendererId;
+        unsigned int m_stride;
         std::shared_ptr<IndexBuffer> m_indexBuffer;
 
     public:
@@ -16,7 +19,15 @@ namespace engine {
         void bind();
         void unbind();
         void addBuffer(std::shared_ptr<VertexBuffer> vertexBuffer, std::shared_ptr<IndexBuffer> indexBuffer);
+        // Sets up the attributes. Only once per vertex array, the buffers can change afterwards
+        void setLayout(BufferLayout& layout);
+        // Attaches the buffers to read from, in the set layout. Cheap with direct state access (GL 4.5)
+        void setBuffers(unsigned int vertexBufferId, unsigned int indexBufferId);
         inline const std::shared_ptr<IndexBuffer>& getIndexBuffer() {return m_indexBuffer;};
+
+        // A vertex array shared by every user of an equal layout, so the attributes are only set up once. Shared, so
+        // set the buffers every time before drawing with it
+        static const std::shared_ptr<VertexArray>& get(BufferLayout& layout);
     };
 
 }
\ No newline at end of file
@@ -1,29 +1,62 @@
 #include "VertexBuffer.h"
 
+#include "../../core/render/DeletionQueue.h"
+
+#include <stdexcept>
+
 namespace engine {
 
     VertexBuffer::VertexBuffer(BufferLayout& layout, const void *data, unsigned int size)
-        : m_dynamic(false), m_layout{layout} {
+        : m_size(size), m_dynamic(false), m_mapped(false), m_layout{layout} {
         RenderCommand::createVertexBuffer(m_rendererId, data, size);
     }
 
     VertexBuffer::VertexBuffer(BufferLayout& layout, unsigned int size)
-            : m_dynamic(true), m_layout{layout} {
+            : m_size(size), m_dynamic(true), m_mapped(false), m_layout{layout} {
         RenderCommand::createVertexBuffer(m_rendererId, size);
     }
 
     VertexBuffer::~VertexBuffer() {
-        RenderCommand::deleteBuffer(m_rendererId);
+        DeletionQueue::getInstance().enqueue(GpuResourceType::Buffer, m_rendererId);
     }
 
-    void VertexBuffer::setData(const void *data, unsigned int size) {
+    void VertexBuffer::setData(const void *data, unsigned int size, unsigned int offset) {
 
         if (!m_dynamic) {
             throw std::runtime_error("Can't set data for non-dynamic vertex buffer");
         }
 
-        bind();
-        RenderCommand::submitVertexBufferData(data, size);
+        if (offset + size > m_size) {
+            throw std::runtime_error("Vertex buffer data out of range");
+        }
+
+        RenderCommand::submitBufferData(m_rendererId, data, size, offset);
+    }
+
+    void* VertexBuffer::map(unsigned int offset, unsigned int size, BufferMapFlags flags) {
+
+        if (!m_dynamic) {
+            throw std::runtime_error("Can't map non-dynamic vertex buffer");
+        }
+
+        if (offset + size > m_size) {
+            throw std::runtime_error("Vertex buffer data out of range");
+        }
+
+        if (m_mapped) {
+            throw std::runtime_error("Vertex buffer is already mapped");
+        }
+
+        void* data = RenderCommand::mapBuffer(m_rendererId, offset, size, flags);
+        m_mapped = true;
+
+        return data;
+
+    }
+
+    void VertexBuffer::unmap() {
+        RenderCommand::unmapBuffer(m_rendererId);
+        m_mapped = false;
     }
 
     void VertexBuffer::bind() {
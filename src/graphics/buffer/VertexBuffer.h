@@ -8,16 +8,25 @@ namespace engine {
 
     private:
         unsigned int m_rendererId;
+        unsigned int m_size;
         bool m_dynamic;
+        bool m_mapped;
         BufferLayout m_layout;
     public:
         VertexBuffer(BufferLayout& layout, const void* data, unsigned int size);
         VertexBuffer(BufferLayout& layout, unsigned int size);
         ~VertexBuffer();
-        void setData(const void* data, unsigned int size);
+        // Overwrites size bytes, starting at offset (in bytes)
+        void setData(const void* data, unsigned int size, unsigned int offset = 0);
+        // Maps a range for writing, until unmap(). See BufferMapFlags for avoiding stalls on data the GPU may still be reading
+        void* map(unsigned int offset, unsigned int size, BufferMapFlags flags = BufferMapFlags::InvalidateRange);
+        void unmap();
         void bind();
         void unbind();
         inline BufferLayout& getBufferLayout() {return m_layout;}
+        inline unsigned int getRendererId() {return m_rendererId;}
+        inline unsigned int getSize() {return m_size;}
+        inline bool isMapped() {return m_mapped;}
     };
 
 }
\ No newline at end of file
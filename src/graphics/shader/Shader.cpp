@@ -3,35 +3,99 @@
 #include "shader_utils.h"
 #include "../../core/render/RenderCommand.h"
 
+#include <filesystem>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace engine {
 
+    HandlePool<Shader*, Shader> Shader::m_registry;
+
     Shader::Shader()
-        : m_rendererId(0) {}
+        : m_rendererId(0), m_handle(m_registry.insert(this)) {}
 
     Shader::~Shader() {
+
+        m_registry.release(m_handle);
+
         if (m_rendererId) {
             RenderCommand::deleteShader(m_rendererId);
         }
+
+    }
+
+    void Shader::attach(ShaderType type, const std::string& shaderPath, const std::vector<std::string>& defines) {
+
+        // Sources are only read and preprocessed here, they get compiled together in compile()
+        std::string directory = std::filesystem::path(shaderPath).parent_path().string();
+        std::string shaderSource = resolveShaderIncludes(readFromFile(shaderPath), directory);
+        m_sources.push_back({type, injectShaderDefines(shaderSource, defines)});
+
+    }
+
+    void Shader::compile() {
+        submit();
+        finish();
     }
 
-    void Shader::attach(ShaderType type, const std::string& shaderPath) {
+    void Shader::submit() {
 
         if (!m_rendererId) {
             m_rendererId = RenderCommand::createShaderProgram();
         }
 
-        std::string shaderSource = readFromFile(shaderPath);
-        unsigned int shaderId = RenderCommand::compileShader(type, shaderSource);
-        RenderCommand::attachShader(m_rendererId, shaderId);
-        RenderCommand::deleteShader(shaderId);
+        // Hand everything to the driver, without querying any status, so it can work in the background
+        for (const auto& source : m_sources) {
+            unsigned int shaderId = RenderCommand::submitShader(source.m_type, source.m_source);
+            RenderCommand::attachShader(m_rendererId, shaderId);
+            m_pendingShaderIds.push_back(shaderId);
+        }
+
+        RenderCommand::submitShaderProgram(m_rendererId);
 
     }
 
-    void Shader::compile() const {
-        RenderCommand::compileShaderProgram(m_rendererId);
+    bool Shader::isReady() const {
+        return RenderCommand::isShaderProgramReady(m_rendererId);
+    }
+
+    void Shader::finish() {
+
+        // The compile logs are only worth querying if the link failed
+        if (!RenderCommand::checkShaderProgram(m_rendererId)) {
+            for (auto shaderId : m_pendingShaderIds) {
+                RenderCommand::checkShader(shaderId);
+            }
+        }
+
+        for (auto shaderId : m_pendingShaderIds) {
+            RenderCommand::deleteShader(shaderId);
+        }
+        m_pendingShaderIds.clear();
+
+        reflectUniforms();
+
+    }
+
+    bool Shader::compileFromBinary(unsigned int format, const std::vector<char>& binary) {
+
+        if (!m_rendererId) {
+            m_rendererId = RenderCommand::createShaderProgram();
+        }
+
+        // The driver can reject a binary (e.g. after an update), in which case the program stays unlinked and can still be compiled from source
+        if (!RenderCommand::loadShaderProgramBinary(m_rendererId, format, binary.data(), binary.size())) {
+            return false;
+        }
+
+        reflectUniforms();
+        return true;
+
+    }
+
+    void Shader::getBinary(unsigned int& format, std::vector<char>& binary) const {
+        RenderCommand::getShaderProgramBinary(m_rendererId, format, binary);
     }
 
     void Shader::bind() const {
@@ -41,56 +105,85 @@ namespace engine {
         RenderCommand::bindShader(m_rendererId);
     }
 
-    void Shader::setUniform1i(const std::string& name, int value) {
+    void Shader::reflectUniforms() {
+
+        std::vector<ShaderUniform> uniforms;
+        RenderCommand::getActiveUniforms(m_rendererId, uniforms);
 
-        bind();
-        int location = getUniformLocation(name);
-        RenderCommand::setUniform1i(location, value);
+        m_uniforms.clear();
+        for (auto& uniform : uniforms) {
+            m_uniforms[uniform.m_name] = uniform;
+        }
 
     }
 
-    void Shader::setUniform3f(const std::string& name, const glm::vec3& value) {
+    ShaderUniformHandle Shader::getUniformHandle(const std::string& name) const {
+
+        auto iterator = m_uniforms.find(name);
+        if (iterator == m_uniforms.end()) {
+            return {};
+        }
 
-        bind();
-        int location = getUniformLocation(name);
-        RenderCommand::setUniform3f(location, value);
+        return {iterator->second.m_location, iterator->second.m_type};
 
     }
 
-    void Shader::setUniform4f(const std::string& name, const glm::vec4& value) {
+    void Shader::setUniform1i(ShaderUniformHandle handle, int value) const {
+        RenderCommand::setProgramUniform1i(m_rendererId, handle.m_location, value);
+    }
 
-        bind();
-        int location = getUniformLocation(name);
-        RenderCommand::setUniform4f(location, value);
+    void Shader::setUniform3f(ShaderUniformHandle handle, const glm::vec3& value) const {
+        RenderCommand::setProgramUniform3f(m_rendererId, handle.m_location, value);
+    }
 
+    void Shader::setUniform4f(ShaderUniformHandle handle, const glm::vec4& value) const {
+        RenderCommand::setProgramUniform4f(m_rendererId, handle.m_location, value);
     }
 
-    void Shader::setUniformMat3f(const std::string& name, const glm::mat3& value) {
+    void Shader::setUniformMat3f(ShaderUniformHandle handle, const glm::mat3& value) const {
+        RenderCommand::setProgramUniformMat3f(m_rendererId, handle.m_location, value);
+    }
 
-        bind();
-        int location = getUniformLocation(name);
-        RenderCommand::setUniformMat3f(location, value);
+    void Shader::setUniformMat4f(ShaderUniformHandle handle, const glm::mat4& value) const {
+        RenderCommand::setProgramUniformMat4f(m_rendererId, handle.m_location, value);
+    }
 
+    void Shader::setUniform1i(const std::string& name, int value) const {
+        setUniform1i(getUniformHandle(name), value);
     }
 
-    void Shader::setUniformMat4f(const std::string& name, const glm::mat4& value) {
+    void Shader::setUniform3f(const std::string& name, const glm::vec3& value) const {
+        setUniform3f(getUniformHandle(name), value);
+    }
 
-        bind();
-        int location = getUniformLocation(name);
-        RenderCommand::setUniformMat4f(location, value);
+    void Shader::setUniform4f(const std::string& name, const glm::vec4& value) const {
+        setUniform4f(getUniformHandle(name), value);
+    }
 
+    void Shader::setUniformMat3f(const std::string& name, const glm::mat3& value) const {
+        setUniformMat3f(getUniformHandle(name), value);
     }
 
-    int Shader::getUniformLocation(const std::string& name) {
+    void Shader::setUniformMat4f(const std::string& name, const glm::mat4& value) const {
+        setUniformMat4f(getUniformHandle(name), value);
+    }
+
+    void Shader::bindUniformBlock(const std::string& name, unsigned int bindingPoint) {
+
+        int blockIndex = RenderCommand::getUniformBlockIndex(m_rendererId, name);
 
-        if (m_uniformLocations.find(name) != m_uniformLocations.end()) {
-            return m_uniformLocations[name];
+        if (blockIndex < 0) {
+            throw std::runtime_error("Uniform block doesn't exist");
         }
 
-        int location = RenderCommand::getUniformLocation(m_rendererId, name);
-        m_uniformLocations[name] = location;
-        return location;
+        // Point the block to the binding point, where the uniform buffer is attached
+        RenderCommand::setUniformBlockBinding(m_rendererId, (unsigned int) blockIndex, bindingPoint);
+
+    }
 
+    Shader* Shader::get(ShaderHandle handle) {
+        Shader** shader = m_registry.get(handle);
+        return shader ? *shader : nullptr;
     }
 
-}
\ No newline at end of file
+}
@@ -1,30 +1,83 @@
 #pragma once
 
 #include "../../core/render/RenderApi.h"
+#include "../../core/resource/HandlePool.h"
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace engine {
 
+    // A uniform resolved once, after compiling. A location of -1 means the uniform isn't active, and setting it is a no-op
+    struct ShaderUniformHandle {
+        int m_location = -1;
+        ShaderUniformType m_type = ShaderUniformType::Other;
+        inline bool isValid() const {return m_location >= 0;}
+    };
+
+    struct ShaderSource {
+        ShaderType m_type;
+        std::string m_source;
+    };
+
+    class Shader;
+    using ShaderHandle = Handle<Shader>;
+
     class Shader {
 
     private:
         unsigned int m_rendererId;
-        int getUniformLocation(const std::string& name);
-        std::unordered_map<std::string, int> m_uniformLocations;
+        ShaderHandle m_handle;
+        std::vector<ShaderSource> m_sources;
+        std::vector<unsigned int> m_pendingShaderIds;
+        std::unordered_map<std::string, ShaderUniform> m_uniforms;
+        void reflectUniforms();
+        static HandlePool<Shader*, Shader> m_registry; // Every live shader
     public:
         Shader();
         ~Shader();
-        void attach(ShaderType type, const std::string& shaderPath);
-        void compile() const;
+        // Registered by address, so it can't be copied or moved
+        Shader(Shader const&) = delete;
+        void operator=(Shader const&) = delete;
+        void attach(ShaderType type, const std::string& shaderPath, const std::vector<std::string>& defines = {});
+        void compile();
+
+        // Asynchronous compilation: submit, poll isReady() without blocking, then finish
+        void submit();
+        bool isReady() const;
+        void finish();
+        inline bool isPending() const {return !m_pendingShaderIds.empty();}
+
+        bool compileFromBinary(unsigned int format, const std::vector<char>& binary);
+        void getBinary(unsigned int& format, std::vector<char>& binary) const;
         void bind() const;
-        void setUniform1i(const std::string& name, int value);
-        void setUniform3f(const std::string& name, const glm::vec3& value);
-        void setUniform4f(const std::string& name, const glm::vec4& value);
-        void setUniformMat3f(const std::string& name, const glm::mat3& value);
-        void setUniformMat4f(const std::string& name, const glm::mat4& value);
+
+        inline const std::vector<ShaderSource>& getSources() const {return m_sources;}
+        inline ShaderHandle getHandle() const {return m_handle;}
+
+        // Resolves a handle without touching the shader's reference count, or returns nullptr once the shader is gone
+        static Shader* get(ShaderHandle handle);
+
+        ShaderUniformHandle getUniformHandle(const std::string& name) const;
+        inline const std::unordered_map<std::string, ShaderUniform>& getUniforms() const {return m_uniforms;}
+
+        // Setters by handle don't need the shader to be bound, and don't do any lookup
+        void setUniform1i(ShaderUniformHandle handle, int value) const;
+        void setUniform3f(ShaderUniformHandle handle, const glm::vec3& value) const;
+        void setUniform4f(ShaderUniformHandle handle, const glm::vec4& value) const;
+        void setUniformMat3f(ShaderUniformHandle handle, const glm::mat3& value) const;
+        void setUniformMat4f(ShaderUniformHandle handle, const glm::mat4& value) const;
+
+        // Setters by name resolve the handle first
+        void setUniform1i(const std::string& name, int value) const;
+        void setUniform3f(const std::string& name, const glm::vec3& value) const;
+        void setUniform4f(const std::string& name, const glm::vec4& value) const;
+        void setUniformMat3f(const std::string& name, const glm::mat3& value) const;
+        void setUniformMat4f(const std::string& name, const glm::mat4& value) const;
+
+        void bindUniformBlock(const std::string& name, unsigned int bindingPoint);
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,121 @@
+#include "ShaderBinaryCache.h"
+
+#include "../../core/render/RenderCommand.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace engine {
+
+    ShaderBinaryCache::ShaderBinaryCache(std::string directory)
+        : m_directory(std::move(directory)), m_enabled(false) {
+
+        // Some drivers don't expose any binary format, in which case we always compile from source
+        if (!RenderCommand::supportsShaderProgramBinary()) {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+        if (error) {
+            return;
+        }
+
+        m_driverSignature = RenderCommand::getDriverSignature();
+        m_enabled = true;
+
+    }
+
+    bool ShaderBinaryCache::load(Shader& shader) {
+
+        if (!m_enabled) {
+            return false;
+        }
+
+        std::ifstream file(getCachePath(shader), std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+
+        std::streamoff fileSize = file.tellg();
+        file.seekg(0);
+
+        BinaryHeader header{};
+        file.read((char*) &header, sizeof(BinaryHeader));
+        if (!file || header.m_magic != m_magic) {
+            return false;
+        }
+
+        // The binary fills the rest of the file, so a size that doesn't match it is corrupt, and never allocated
+        if (header.m_size != fileSize - (std::streamoff) sizeof(BinaryHeader)) {
+            return false;
+        }
+
+        std::vector<char> binary(header.m_size);
+        file.read(binary.data(), header.m_size);
+        if (!file) {
+            return false;
+        }
+
+        return shader.compileFromBinary(header.m_format, binary);
+
+    }
+
+    void ShaderBinaryCache::store(const Shader& shader) {
+
+        if (!m_enabled) {
+            return;
+        }
+
+        unsigned int format;
+        std::vector<char> binary;
+        shader.getBinary(format, binary);
+
+        if (binary.empty()) {
+            return;
+        }
+
+        std::ofstream file(getCachePath(shader), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return;
+        }
+
+        BinaryHeader header{m_magic, format, (uint32_t) binary.size()};
+        file.write((const char*) &header, sizeof(BinaryHeader));
+        file.write(binary.data(), (std::streamsize) binary.size());
+
+    }
+
+    uint64_t ShaderBinaryCache::hashShader(const Shader& shader) {
+
+        // FNV-1a, over the driver signature and every (type, source) pair
+        uint64_t hash = 14695981039346656037ull;
+        auto hashBytes = [&hash](const void* data, size_t size) {
+            auto bytes = (const unsigned char*) data;
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        hashBytes(m_driverSignature.data(), m_driverSignature.size());
+        for (const auto& source : shader.getSources()) {
+            hashBytes(&source.m_type, sizeof(ShaderType));
+            hashBytes(source.m_source.data(), source.m_source.size());
+        }
+
+        return hash;
+
+    }
+
+    std::string ShaderBinaryCache::getCachePath(const Shader& shader) {
+
+        std::stringstream path;
+        path << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hashShader(shader) << ".bin";
+        return path.str();
+
+    }
+
+}
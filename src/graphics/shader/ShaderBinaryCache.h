@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Shader.h"
+
+#include <cstdint>
+#include <string>
+
+namespace engine {
+
+    // Stores linked program binaries on disk, keyed by a hash of the shader sources and the driver signature
+    class ShaderBinaryCache {
+
+    public:
+        explicit ShaderBinaryCache(std::string directory);
+
+        bool load(Shader& shader);
+        void store(const Shader& shader);
+
+    private:
+        std::string m_directory;
+        std::string m_driverSignature;
+        bool m_enabled;
+
+        uint64_t hashShader(const Shader& shader);
+        std::string getCachePath(const Shader& shader);
+
+        struct BinaryHeader {
+            uint32_t m_magic;
+            uint32_t m_format;
+            uint32_t m_size;
+        };
+
+        static const uint32_t m_magic = 0x42534547; // "GESB"
+
+    };
+
+}
@@ -1,25 +1,92 @@
 #include "ShaderLibrary.h"
 
 #include "exception"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 namespace engine {
 
     std::shared_ptr<Shader> ShaderLibrary::load(const std::string& name, const std::map<ShaderType, std::string>& shaderSources) {
 
+        std::shared_ptr<Shader> shader = submit(name, shaderSources);
+
+        if (shader->isPending()) {
+            finish(shader);
+        }
+
+        return shader;
+
+    }
+
+    void ShaderLibrary::load(const std::map<std::string, std::map<ShaderType, std::string> >& shaders) {
+
+        // Submit everything first, so the driver can overlap the compilation of all the shaders
+        for (const auto& shader : shaders) {
+            submit(shader.first, shader.second);
+        }
+
+        while (!poll()) {
+            std::this_thread::yield();
+        }
+
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::submit(const std::string& name, const std::map<ShaderType, std::string>& shaderSources, const std::vector<std::string>& defines) {
+
         std::shared_ptr<Shader> shader = std::make_shared<engine::Shader>();
 
         for (const auto& shaderSource : shaderSources) {
-            shader->attach(shaderSource.first, shaderSource.second);
+            shader->attach(shaderSource.first, shaderSource.second, defines);
         }
 
-        shader->compile();
-
         add(name, shader);
+        m_shaderSources[name] = shaderSources;
+
+        // Try the program binary cache first, and fall back to compiling from source
+        if (!m_binaryCache || !m_binaryCache->load(*shader)) {
+            shader->submit();
+            m_pendingShaders.push_back(shader);
+        }
 
         return shader;
 
     }
 
+    bool ShaderLibrary::poll() {
+
+        // Finish only the shaders the driver is done with, the rest stay pending
+        for (auto iterator = m_pendingShaders.begin(); iterator != m_pendingShaders.end();) {
+
+            if ((*iterator)->isReady()) {
+                auto shader = *iterator;
+                iterator = m_pendingShaders.erase(iterator);
+                finish(shader);
+            } else {
+                iterator++;
+            }
+
+        }
+
+        return m_pendingShaders.empty();
+
+    }
+
+    void ShaderLibrary::finish(const std::shared_ptr<Shader>& shader) {
+
+        shader->finish();
+
+        auto iterator = std::find(m_pendingShaders.begin(), m_pendingShaders.end(), shader);
+        if (iterator != m_pendingShaders.end()) {
+            m_pendingShaders.erase(iterator);
+        }
+
+        if (m_binaryCache) {
+            m_binaryCache->store(*shader);
+        }
+
+    }
+
     std::shared_ptr<Shader> ShaderLibrary::add(const std::string& name, const std::shared_ptr<Shader>& shader) {
 
         if (m_shaders.find(name) != m_shaders.end()) {
@@ -38,8 +105,67 @@ namespace engine {
             throw std::runtime_error("Shader doesn't exist");
         }
 
-        return m_shaders[name];
+        auto& shader = m_shaders[name];
+
+        // A shader that is still compiling has to be finished before it can be used
+        if (shader->isPending()) {
+            finish(shader);
+        }
+
+        return shader;
+
+    }
+
+    ShaderHandle ShaderLibrary::getHandle(const std::string& name) {
+        return get(name)->getHandle();
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::getVariant(const std::string& name, const std::vector<std::string>& defines) {
+
+        std::string variantName = getVariantName(name, defines);
+
+        auto iterator = m_shaders.find(variantName);
+        if (iterator != m_shaders.end()) {
+            return get(variantName);
+        }
+
+        auto sources = m_shaderSources.find(name);
+        if (sources == m_shaderSources.end()) {
+            throw std::runtime_error("Shader doesn't exist");
+        }
+
+        // Copy the sources, since loading the variant inserts into m_shaderSources
+        auto shaderSources = sources->second;
+        std::shared_ptr<Shader> shader = submit(variantName, shaderSources, defines);
+
+        if (shader->isPending()) {
+            finish(shader);
+        }
+
+        return shader;
+
+    }
+
+    std::string ShaderLibrary::getVariantName(const std::string& name, std::vector<std::string> defines) {
+
+        if (defines.empty()) {
+            return name;
+        }
+
+        // The order of the defines doesn't matter, so it doesn't change the key either
+        std::sort(defines.begin(), defines.end());
+
+        std::string variantName = name + "[";
+        for (unsigned int i = 0; i < defines.size(); i++) {
+            variantName += (i ? "," : "") + defines[i];
+        }
+
+        return variantName + "]";
+
+    }
 
+    void ShaderLibrary::enableBinaryCache(const std::string& directory) {
+        m_binaryCache = std::make_shared<ShaderBinaryCache>(directory);
     }
 
 }
\ No newline at end of file
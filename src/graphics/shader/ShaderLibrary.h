@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Shader.h"
+#include "ShaderBinaryCache.h"
 
 #include <map>
 
@@ -12,11 +13,30 @@ namespace engine {
         ShaderLibrary() = default;
 
         std::shared_ptr<Shader> load(const std::string& name, const std::map<ShaderType, std::string>& shaderSources);
+        void load(const std::map<std::string, std::map<ShaderType, std::string> >& shaders);
+
+        // Asynchronous loading: submit shaders, and poll() them (e.g. once per frame) until it returns true
+        std::shared_ptr<Shader> submit(const std::string& name, const std::map<ShaderType, std::string>& shaderSources, const std::vector<std::string>& defines = {});
+        bool poll();
+
+        // Variants of a loaded shader, compiled with extra #defines the first time they are requested
+        std::shared_ptr<Shader> getVariant(const std::string& name, const std::vector<std::string>& defines);
+
         std::shared_ptr<Shader> add(const std::string& name, const std::shared_ptr<Shader>& shader);
         std::shared_ptr<Shader> get(const std::string& name);
+        // Look the handle up once, then resolve it with Shader::get() in hot paths, instead of by name
+        ShaderHandle getHandle(const std::string& name);
+
+        void enableBinaryCache(const std::string& directory);
 
     private:
         std::unordered_map<std::string, std::shared_ptr<Shader> > m_shaders;
+        std::shared_ptr<ShaderBinaryCache> m_binaryCache = nullptr;
+        std::vector<std::shared_ptr<Shader> > m_pendingShaders;
+        std::unordered_map<std::string, std::map<ShaderType, std::string> > m_shaderSources;
+
+        void finish(const std::shared_ptr<Shader>& shader);
+        static std::string getVariantName(const std::string& name, std::vector<std::string> defines);
 
     };
 
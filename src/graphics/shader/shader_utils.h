@@ -1,30 +1,82 @@
 #pragma once
 
+#include "../../core/filesystem/AssetPack.h"
+
 #include <iostream>
-#include <fstream>
 #include <sstream>
+#include <filesystem>
+#include <vector>
+#include <stdexcept>
 
 namespace engine {
 
     std::string readFromFile(const std::string& filePath) {
 
-        std::string fileContent;
-        std::ifstream file;
+        // Served from a mounted asset pack if packed, or from the loose file otherwise
+        AssetFile file(filePath);
+
+        if (!file.isOpen()) {
+            std::cout << "Error while reading from file '" << filePath.c_str() << "'" << std::endl;
+            return "";
+        }
+
+        return std::string((const char*) file.getData(), file.getSize());
+
+    }
+
+    std::string resolveShaderIncludes(const std::string& source, const std::string& directory) {
+
+        std::stringstream input(source);
+        std::stringstream output;
+        std::string line;
+
+        // Replace every `#include "path"` line with the (recursively resolved) content of that file, relative to the including one
+        while (std::getline(input, line)) {
+
+            auto start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+                output << line << "\n";
+                continue;
+            }
+
+            auto open = line.find('"', start);
+            auto close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+            if (close == std::string::npos) {
+                throw std::runtime_error("Malformed shader #include");
+            }
+
+            std::filesystem::path includePath = std::filesystem::path(directory) / line.substr(open + 1, close - open - 1);
+            output << resolveShaderIncludes(readFromFile(includePath.string()), includePath.parent_path().string()) << "\n";
 
-        // Make sure to throw exception if anything fails
-        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        }
+
+        return output.str();
+
+    }
+
+    std::string injectShaderDefines(const std::string& source, const std::vector<std::string>& defines) {
+
+        if (defines.empty()) {
+            return source;
+        }
+
+        std::string defineLines;
+        for (const auto& define : defines) {
+            defineLines += "#define " + define + "\n";
+        }
+
+        // The defines have to go right after #version, which must stay the first statement
+        auto version = source.find("#version");
+        if (version == std::string::npos) {
+            return defineLines + source;
+        }
 
-        try {
-            file.open(filePath.c_str());
-            std::stringstream fileStream;
-            fileStream << file.rdbuf();
-            file.close();
-            fileContent = fileStream.str();
-        } catch (std::ifstream::failure& e) {
-            std::cout << "Error while reading from file '" << filePath.c_str() << "': " << e.what() << std::endl;
+        auto lineEnd = source.find('\n', version);
+        if (lineEnd == std::string::npos) {
+            return source + "\n" + defineLines;
         }
 
-        return fileContent;
+        return source.substr(0, lineEnd + 1) + defineLines + source.substr(lineEnd + 1);
 
     }
 
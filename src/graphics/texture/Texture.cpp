@@ -1,45 +1,305 @@
 #include "Texture.h"
 
+#include "TextureContainer.h"
 #include "../../core/render/RenderCommand.h"
+#include "../../core/render/DeletionQueue.h"
+#include "../../core/render/GpuMemoryTracker.h"
+#include "../../core/filesystem/AssetPack.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace engine {
 
-    Texture::Texture(const std::string &path) {
+    std::weak_ptr<Texture> Texture::m_placeholder;
+    HandlePool<Texture*, Texture> Texture::m_registry;
 
-        int width, height, channels;
-        stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    Texture::Texture(const TextureOptions& options)
+        : m_rendererId(0), m_handle(m_registry.insert(this)), m_width(0), m_height(0), m_residentSize(0), m_format(TextureFormat::RGB8), m_options(options), m_mipmapped(false), m_mappedRegion{} {}
 
-        if (!data) {
-            throw std::runtime_error("Failed to load texture file");
+    Texture::Texture(const std::string &path, const TextureOptions& options)
+        : m_rendererId(0), m_handle(m_registry.insert(this)), m_width(0), m_height(0), m_residentSize(0), m_format(TextureFormat::RGB8), m_options(options), m_mipmapped(false), m_mappedRegion{} {
+
+        // The destructor won't run if the constructor throws, so unregister here
+        try {
+
+            AssetFile file(path);
+
+            if (!file.isOpen()) {
+                throw std::runtime_error("Failed to load texture file");
+            }
+
+            loadFromMemory(file.getData(), file.getSize());
+            setDebugLabel(path);
+
+        } catch (...) {
+            m_registry.release(m_handle);
+            throw;
         }
 
-        RenderCommand::loadTexture(m_rendererId, (unsigned int) width, (unsigned int) height, data);
+    }
 
-        stbi_image_free(data);
+    Texture::Texture(unsigned int width, unsigned int height, void* data, TextureFormat format)
+        : m_rendererId(0), m_handle(m_registry.insert(this)), m_width(0), m_height(0), m_residentSize(0), m_format(format), m_mipmapped(false), m_mappedRegion{} {
+        load(width, height, data, format);
+    }
 
-        m_width = width;
-        m_height = height;
+    Texture::~Texture() {
+
+        m_registry.release(m_handle);
+
+        if (m_rendererId) {
+            DeletionQueue::getInstance().enqueue(GpuResourceType::Texture, m_rendererId);
+        }
 
     }
 
-    Texture::Texture(unsigned int width, unsigned int height, void* data) {
+    void Texture::load(unsigned int width, unsigned int height, const void* data, TextureFormat format) {
+
+        if (m_rendererId) {
+            DeletionQueue::getInstance().enqueue(GpuResourceType::Texture, m_rendererId);
+        }
 
-        RenderCommand::loadTexture(m_rendererId, (unsigned int) width, (unsigned int) height, data);
+        RenderCommand::loadTexture(m_rendererId, width, height, format, data);
 
         m_width = width;
         m_height = height;
+        m_format = format;
+        m_mipmapped = true;
+        m_pixelBuffers.reset();
+
+        // Plus a third for the generated mip chain
+        m_residentSize = (size_t) width * height * getBytesPerPixel(format) * 4 / 3;
 
     }
 
-    Texture::~Texture() {
-        RenderCommand::deleteTexture(m_rendererId);
+    void Texture::loadPixels(unsigned int width, unsigned int height, unsigned int channels, const void* data) {
+
+        // There's no single-channel sRGB format, so grayscale stays linear
+        TextureFormat format;
+        switch (channels) {
+            case 1: format = m_options.m_alphaMask ? TextureFormat::A8 : TextureFormat::R8; break;
+            case 2: format = TextureFormat::RG8; break;
+            case 3: format = m_options.m_srgb ? TextureFormat::SRGB8 : TextureFormat::RGB8; break;
+            case 4: format = m_options.m_srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8; break;
+            default: throw std::runtime_error("Unsupported texture channel count");
+        }
+
+        load(width, height, data, format);
+
+    }
+
+    void Texture::loadFromMemory(const unsigned char* data, size_t size) {
+
+        // Pre-baked containers are uploaded as they are, any other image goes through stb_image
+        if (isTextureContainer(data, size)) {
+            loadContainer(data, size);
+            return;
+        }
+
+        // Keep the file's own channel count, so masks stay single-channel in video memory
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load_from_memory(data, (int) size, &width, &height, &channels, 0);
+
+        if (!pixels) {
+            throw std::runtime_error("Failed to load texture file");
+        }
+
+        loadPixels((unsigned int) width, (unsigned int) height, (unsigned int) channels, pixels);
+
+        stbi_image_free(pixels);
+
+    }
+
+    void Texture::loadContainer(const unsigned char* data, size_t size, unsigned int maxDimension) {
+
+        TextureContainerHeader header{};
+        std::memcpy(&header, data, sizeof(TextureContainerHeader));
+
+        size_t levelsEnd = sizeof(TextureContainerHeader) + header.m_levelCount * sizeof(TextureContainerLevel);
+        if (header.m_magic != TEXTURE_CONTAINER_MAGIC || header.m_version != TEXTURE_CONTAINER_VERSION || header.m_levelCount == 0 || levelsEnd > size) {
+            throw std::runtime_error("Invalid texture container");
+        }
+
+        TextureFormat format;
+        switch (header.m_format) {
+            case TextureContainerFormat::RGBA8: format = m_options.m_srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8; break;
+            case TextureContainerFormat::BC1: format = TextureFormat::BC1; break;
+            case TextureContainerFormat::BC3: format = TextureFormat::BC3; break;
+            default: throw std::runtime_error("Invalid texture container");
+        }
+
+        std::vector<TextureContainerLevel> levels(header.m_levelCount);
+        std::memcpy(levels.data(), data + sizeof(TextureContainerHeader), header.m_levelCount * sizeof(TextureContainerLevel));
+
+        // Every level is checked before the old texture is replaced, so a corrupt container leaves the texture as it was
+        unsigned int width = header.m_width;
+        unsigned int height = header.m_height;
+        for (unsigned int i = 0; i < header.m_levelCount; i++) {
+
+            // Each level halves the one before, down to 1x1 and no further
+            bool consistent = width && height && levels[i].m_width == width && levels[i].m_height == height
+                && levels[i].m_size == GpuMemoryTracker::getTextureLevelSize(format, width, height);
+            bool inBounds = levels[i].m_offset <= size && levels[i].m_size <= size - levels[i].m_offset;
+            if (!consistent || !inBounds) {
+                throw std::runtime_error("Invalid texture container");
+            }
+
+            bool smallest = width == 1 && height == 1;
+            width = smallest ? 0 : std::max(width / 2, 1u);
+            height = smallest ? 0 : std::max(height / 2, 1u);
+
+        }
+
+        // Skip the levels over the maximum dimension, but keep at least the smallest one
+        unsigned int firstLevel = 0;
+        while (maxDimension && firstLevel + 1 < header.m_levelCount && std::max(levels[firstLevel].m_width, levels[firstLevel].m_height) > maxDimension) {
+            firstLevel++;
+        }
+
+        if (m_rendererId) {
+            DeletionQueue::getInstance().enqueue(GpuResourceType::Texture, m_rendererId);
+        }
+
+        RenderCommand::createTexture(m_rendererId, header.m_levelCount - firstLevel);
+        m_residentSize = 0;
+
+        // Every level is uploaded straight from the file data, the mip chain was generated offline
+        for (unsigned int i = firstLevel; i < header.m_levelCount; i++) {
+            RenderCommand::loadTextureLevel(i - firstLevel, format, levels[i].m_width, levels[i].m_height, data + levels[i].m_offset, (unsigned int) levels[i].m_size);
+            m_residentSize += levels[i].m_size;
+        }
+
+        // Reduced textures keep their full size, it's what they'll be once reloaded
+        m_width = header.m_width;
+        m_height = header.m_height;
+        m_format = format;
+        m_mipmapped = header.m_levelCount - firstLevel > 1;
+        m_pixelBuffers.reset();
+
+    }
+
+    void Texture::unload() {
+
+        if (m_rendererId) {
+            DeletionQueue::getInstance().enqueue(GpuResourceType::Texture, m_rendererId);
+            m_rendererId = 0;
+        }
+
+        m_residentSize = 0;
+        m_pixelBuffers.reset();
+
     }
 
     void Texture::bind(unsigned int slot) {
+
+        // Until the texture is loaded, it's bound as the placeholder
+        if (!m_rendererId) {
+            auto placeholder = m_placeholder.lock();
+            if (placeholder && placeholder.get() != this) {
+                placeholder->bind(slot);
+                return;
+            }
+        }
+
         RenderCommand::bindTexture(m_rendererId, slot);
+
+    }
+
+    void Texture::setDebugLabel(const std::string& label) {
+
+        if (m_rendererId) {
+            RenderCommand::setDebugLabel(GpuResourceType::Texture, m_rendererId, label);
+        }
+
+    }
+
+    void Texture::update(const TextureRegion& region, const void* data) {
+
+        void* pixels = map(region);
+        std::memcpy(pixels, data, (size_t) region.m_width * region.m_height * getBytesPerPixel(m_format));
+
+        // The mapped memory got corrupted, so upload straight from the data instead
+        if (!unmap()) {
+            RenderCommand::updateTexture(m_rendererId, m_format, region.m_x, region.m_y, region.m_width, region.m_height, data);
+            if (m_mipmapped) {
+                RenderCommand::generateTextureMipmaps(m_rendererId);
+            }
+        }
+
+    }
+
+    void* Texture::map(const TextureRegion& region) {
+
+        if (!m_rendererId || m_format == TextureFormat::BC1 || m_format == TextureFormat::BC3) {
+            throw std::runtime_error("Texture can't be updated");
+        }
+
+        if (region.m_x + region.m_width > m_width || region.m_y + region.m_height > m_height) {
+            throw std::runtime_error("Texture region out of range");
+        }
+
+        unsigned int bytesPerPixel = getBytesPerPixel(m_format);
+
+        // Sized for the whole texture, so any region fits
+        if (!m_pixelBuffers) {
+            m_pixelBuffers = std::make_unique<PixelBufferRing>(m_width * m_height * bytesPerPixel);
+        }
+
+        m_mappedRegion = region;
+        return m_pixelBuffers->map(region.m_width * region.m_height * bytesPerPixel);
+
+    }
+
+    bool Texture::unmap() {
+
+        if (!m_pixelBuffers || !m_pixelBuffers->isMapped()) {
+            throw std::runtime_error("Texture is not mapped");
+        }
+
+        // Nothing to upload if the mapped memory got corrupted
+        if (!m_pixelBuffers->unmap()) {
+            m_pixelBuffers->unbind();
+            return false;
+        }
+
+        // The pixel buffer is bound again, so the data is read from the start of it
+        RenderCommand::updateTexture(m_rendererId, m_format, m_mappedRegion.m_x, m_mappedRegion.m_y, m_mappedRegion.m_width, m_mappedRegion.m_height, nullptr);
+        m_pixelBuffers->unbind();
+
+        if (m_mipmapped) {
+            RenderCommand::generateTextureMipmaps(m_rendererId);
+        }
+
+        return true;
+
+    }
+
+    Texture* Texture::get(TextureHandle handle) {
+        Texture** texture = m_registry.get(handle);
+        return texture ? *texture : nullptr;
+    }
+
+    void Texture::setPlaceholder(const std::shared_ptr<Texture>& placeholder) {
+        m_placeholder = placeholder;
+    }
+
+    unsigned int Texture::getBytesPerPixel(TextureFormat format) {
+
+        switch (format) {
+            case TextureFormat::R8:
+            case TextureFormat::A8:             return 1;
+            case TextureFormat::RG8:            return 2;
+            case TextureFormat::RGB8:
+            case TextureFormat::SRGB8:          return 3;
+            case TextureFormat::RGBA8:
+            case TextureFormat::SRGB8_ALPHA8:   return 4;
+            default:                            throw std::runtime_error("Texture format has no fixed pixel size");
+        }
+
     }
 
-}
\ No newline at end of file
+}
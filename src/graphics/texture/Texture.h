@@ -1,24 +1,95 @@
 #pragma once
 
+#include "../../core/render/RenderApi.h"
+#include "../buffer/PixelBufferRing.h"
+#include "../../core/resource/HandlePool.h"
+
+#include <cstddef>
+#include <memory>
 #include <string>
 
 namespace engine {
 
+    struct TextureRegion {
+        unsigned int m_x;
+        unsigned int m_y;
+        unsigned int m_width;
+        unsigned int m_height;
+    };
+
+    // How decoded images are stored, picked from their channel count
+    struct TextureOptions {
+        bool m_srgb = false; // RGB(A) color data, decoded to linear when sampled
+        bool m_alphaMask = false; // Single-channel images are read as alpha (masks, fonts) instead of grayscale
+    };
+
+    class Texture;
+    using TextureHandle = Handle<Texture>;
+
     class Texture {
 
     public:
-        Texture(const std::string& path);
-        Texture(unsigned int width, unsigned int height, void* data);
+        explicit Texture(const TextureOptions& options = TextureOptions());
+        Texture(const std::string& path, const TextureOptions& options = TextureOptions());
+        Texture(unsigned int width, unsigned int height, void* data, TextureFormat format = TextureFormat::RGB8);
         ~Texture();
 
+        // Registered by address, so it can't be copied or moved
+        Texture(Texture const&) = delete;
+        void operator=(Texture const&) = delete;
+
+        void load(unsigned int width, unsigned int height, const void* data, TextureFormat format = TextureFormat::RGB8);
+        // Decoded pixels, with 1 to 4 channels, stored in the format matching the texture's options
+        void loadPixels(unsigned int width, unsigned int height, unsigned int channels, const void* data);
+        void loadFromMemory(const unsigned char* data, size_t size);
+        // Only the levels no larger than maxDimension are loaded, if given (the smallest one always is)
+        void loadContainer(const unsigned char* data, size_t size, unsigned int maxDimension = 0);
+        // Frees the video memory, the texture is bound as the placeholder until it's loaded again
+        void unload();
         void bind(unsigned int slot = 0);
+        // Names the loaded texture in GPU debuggers and the memory overlay
+        void setDebugLabel(const std::string& label);
+
+        // Streams new texels into a region through a ring of pixel buffers, so the upload doesn't stall (uncompressed formats only)
+        void update(const TextureRegion& region, const void* data);
+        // Same as update, but the producer writes the region's texels (tightly packed) straight into the returned memory
+        void* map(const TextureRegion& region);
+        // Returns false if the mapped memory got corrupted before the upload, then the region has to be written again
+        bool unmap();
+
+        inline bool isLoaded() const {return m_rendererId != 0;}
+        inline unsigned int getWidth() const {return m_width;}
+        inline unsigned int getHeight() const {return m_height;}
+        inline size_t getResidentSize() const {return m_residentSize;} // Bytes in video memory, including the mip chain
+        inline TextureFormat getFormat() const {return m_format;}
+        inline const TextureOptions& getOptions() const {return m_options;}
+        inline TextureHandle getHandle() const {return m_handle;}
+
+        // Resolves a handle without touching the texture's reference count, or returns nullptr once the texture is gone
+        static Texture* get(TextureHandle handle);
+
+        // Textures that aren't loaded yet are bound as this one instead
+        static void setPlaceholder(const std::shared_ptr<Texture>& placeholder);
 
     private:
         unsigned int m_rendererId;
+        TextureHandle m_handle;
 
         unsigned int m_width;
         unsigned int m_height;
+        size_t m_residentSize;
+        TextureFormat m_format;
+        TextureOptions m_options;
+        bool m_mipmapped;
+
+        std::unique_ptr<PixelBufferRing> m_pixelBuffers; // Only created on the first update
+        TextureRegion m_mappedRegion;
+
+        static std::weak_ptr<Texture> m_placeholder;
+        static HandlePool<Texture*, Texture> m_registry; // Every live texture
+
+        static unsigned int getBytesPerPixel(TextureFormat format);
 
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+#include "TextureAtlas.h"
+
+#include "TextureCache.h"
+#include "../../core/filesystem/AssetPack.h"
+
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+namespace engine {
+
+    TextureAtlas::TextureAtlas(const std::string& path) {
+
+        AssetFile file(path);
+
+        if (!file.isOpen()) {
+            throw std::runtime_error("Failed to load texture atlas file");
+        }
+
+        // The pages are next to the lookup table
+        std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+        std::istringstream input(std::string((const char*) file.getData(), file.getSize()));
+        std::string line;
+        while (std::getline(input, line)) {
+
+            std::istringstream lineInput(line);
+            std::string type;
+            lineInput >> type;
+
+            if (type == "page") {
+
+                std::string pagePath;
+                lineInput >> pagePath;
+                m_pages.push_back(TextureCache::getInstance().load((directory / pagePath).string()));
+
+            } else if (type == "region") {
+
+                std::string name;
+                unsigned int page;
+                TextureAtlasRegion region;
+                lineInput >> name >> page >> region.m_textureCoordinatesMin.x >> region.m_textureCoordinatesMin.y >> region.m_textureCoordinatesMax.x >> region.m_textureCoordinatesMax.y;
+
+                if (lineInput.fail() || page >= m_pages.size()) {
+                    throw std::runtime_error("Invalid texture atlas file");
+                }
+
+                region.m_texture = m_pages[page];
+                m_regions[name] = region;
+
+            }
+
+        }
+
+    }
+
+    bool TextureAtlas::hasRegion(const std::string& name) const {
+        return m_regions.find(name) != m_regions.end();
+    }
+
+    const TextureAtlasRegion& TextureAtlas::getRegion(const std::string& name) const {
+
+        auto region = m_regions.find(name);
+        if (region == m_regions.end()) {
+            throw std::runtime_error("Texture atlas region '" + name + "' not found");
+        }
+
+        return region->second;
+
+    }
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Texture.h"
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // A sprite's page, and its UV rectangle inside it
+    struct TextureAtlasRegion {
+        std::shared_ptr<Texture> m_texture;
+        glm::vec2 m_textureCoordinatesMin;
+        glm::vec2 m_textureCoordinatesMax;
+    };
+
+    // Loads a lookup table written by tools/atlas-packer, and its pages (through the TextureCache)
+    class TextureAtlas {
+
+    public:
+        explicit TextureAtlas(const std::string& path);
+
+        bool hasRegion(const std::string& name) const;
+        // By the image's path relative to the packed directory, without extension
+        const TextureAtlasRegion& getRegion(const std::string& name) const;
+
+        inline const std::vector<std::shared_ptr<Texture> >& getPages() const {return m_pages;}
+
+    private:
+        std::vector<std::shared_ptr<Texture> > m_pages;
+        std::unordered_map<std::string, TextureAtlasRegion> m_regions;
+
+    };
+
+}
@@ -0,0 +1,143 @@
+#include "TextureCache.h"
+
+#include "TextureResidencyManager.h"
+
+#include <filesystem>
+
+namespace engine {
+
+    std::shared_ptr<Texture> TextureCache::load(const std::string& path, const TextureOptions& options) {
+
+        std::string key = getKey(path, options);
+
+        // A texture still loading asynchronously is returned as it is, and bound as the placeholder until then
+        auto texture = find(key);
+        if (texture) {
+            return texture;
+        }
+
+        texture = std::make_shared<Texture>(path, options);
+        m_entries[key] = {texture, {}};
+        TextureResidencyManager::getInstance().track(texture, path);
+
+        return texture;
+
+    }
+
+    std::shared_ptr<Texture> TextureCache::loadAsync(const std::string& path, TextureLoader::Callback callback, const TextureOptions& options) {
+
+        std::string key = getKey(path, options);
+
+        auto texture = find(key);
+        if (texture) {
+
+            if (!callback) {
+                return texture;
+            }
+
+            // Still loading, so wait for it along with the first request
+            auto entry = m_entries.find(key);
+            if (!texture->isLoaded() && !entry->second.m_callbacks.empty()) {
+                entry->second.m_callbacks.push_back(std::move(callback));
+            } else {
+                callback(texture, texture->isLoaded());
+            }
+
+            return texture;
+
+        }
+
+        Entry entry;
+        // Never empty while the load is pending, so later hits know to wait
+        entry.m_callbacks.emplace_back(std::move(callback));
+
+        texture = TextureLoader::getInstance().load(path, [this, key](const std::shared_ptr<Texture>& texture, bool loaded) {
+
+            auto entry = m_entries.find(key);
+            if (entry == m_entries.end()) {
+                return;
+            }
+
+            std::vector<TextureLoader::Callback> callbacks;
+            callbacks.swap(entry->second.m_callbacks);
+
+            for (auto& callback : callbacks) {
+                if (callback) {
+                    callback(texture, loaded);
+                }
+            }
+
+        }, options);
+
+        entry.m_texture = texture;
+        m_entries[key] = std::move(entry);
+        TextureResidencyManager::getInstance().track(texture, path);
+
+        return texture;
+
+    }
+
+    unsigned int TextureCache::getEntryCount() {
+        prune();
+        return m_entries.size();
+    }
+
+    size_t TextureCache::getResidentSize() {
+
+        size_t residentSize = 0;
+        for (auto& entry : m_entries) {
+            auto texture = entry.second.m_texture.lock();
+            if (texture) {
+                residentSize += texture->getResidentSize();
+            }
+        }
+
+        return residentSize;
+
+    }
+
+    std::shared_ptr<Texture> TextureCache::find(const std::string& key) {
+
+        auto entry = m_entries.find(key);
+        auto texture = entry != m_entries.end() ? entry->second.m_texture.lock() : nullptr;
+
+        if (texture) {
+            m_hitCount++;
+            return texture;
+        }
+
+        // Misses are rare and already expensive, so that's when the released entries are dropped
+        m_missCount++;
+        prune();
+
+        return nullptr;
+
+    }
+
+    void TextureCache::prune() {
+
+        for (auto entry = m_entries.begin(); entry != m_entries.end();) {
+            if (entry->second.m_texture.expired()) {
+                entry = m_entries.erase(entry);
+            } else {
+                entry++;
+            }
+        }
+
+    }
+
+    std::string TextureCache::getKey(const std::string& path, const TextureOptions& options) {
+
+        // "assets/a.png", "./assets/a.png" and its absolute path are the same texture
+        std::error_code error;
+        std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+        if (error) {
+            canonicalPath = std::filesystem::absolute(path).lexically_normal();
+        }
+
+        // The same file loaded with other options is another texture
+        return canonicalPath.generic_string() + (options.m_srgb ? "|srgb" : "") + (options.m_alphaMask ? "|alpha-mask" : "");
+
+    }
+
+}
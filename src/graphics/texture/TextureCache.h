@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Texture.h"
+#include "TextureLoader.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Shares textures by canonical path and options, so a file is only decoded and uploaded once while anybody holds it
+    // The cache only holds weak references: a texture is freed when its last user releases it
+    // Its textures are tracked by the TextureResidencyManager, to keep them within the video memory budget
+    class TextureCache {
+
+    private:
+        TextureCache() = default;
+
+    public:
+        static TextureCache& getInstance() {
+            static TextureCache m_instance;
+            return m_instance;
+        }
+        TextureCache(TextureCache const&) = delete;
+        void operator=(TextureCache const&) = delete;
+
+        // Loads right away, on a miss
+        std::shared_ptr<Texture> load(const std::string& path, const TextureOptions& options = TextureOptions());
+        // Loads through the TextureLoader, on a miss. The callback runs once the texture is uploaded, even on a hit
+        std::shared_ptr<Texture> loadAsync(const std::string& path, TextureLoader::Callback callback = nullptr, const TextureOptions& options = TextureOptions());
+
+        inline unsigned int getHitCount() const {return m_hitCount;}
+        inline unsigned int getMissCount() const {return m_missCount;}
+        unsigned int getEntryCount();
+        size_t getResidentSize();
+
+    private:
+
+        struct Entry {
+            std::weak_ptr<Texture> m_texture;
+            std::vector<TextureLoader::Callback> m_callbacks; // Waiting for the async load
+        };
+
+        std::unordered_map<std::string, Entry> m_entries;
+
+        unsigned int m_hitCount = 0;
+        unsigned int m_missCount = 0;
+
+        std::shared_ptr<Texture> find(const std::string& key);
+        void prune();
+        static std::string getKey(const std::string& path, const TextureOptions& options);
+
+    };
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// On-disk layout of the engine's pre-baked textures, written by tools/texture-baker:
+// a TextureContainerHeader, followed by one TextureContainerLevel per mip level (largest first), followed by the level data
+namespace engine {
+
+    enum class TextureContainerFormat : uint32_t {
+        RGBA8 = 0,
+        BC1 = 1,
+        BC3 = 2
+    };
+
+    struct TextureContainerHeader {
+        uint32_t m_magic;
+        uint32_t m_version;
+        TextureContainerFormat m_format;
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_levelCount;
+    };
+
+    struct TextureContainerLevel {
+        uint32_t m_width;
+        uint32_t m_height;
+        uint64_t m_offset; // From the start of the file
+        uint64_t m_size;
+    };
+
+    static const uint32_t TEXTURE_CONTAINER_MAGIC = 0x58544547; // "GETX"
+    static const uint32_t TEXTURE_CONTAINER_VERSION = 1;
+
+    inline bool isTextureContainer(const unsigned char* data, size_t size) {
+
+        if (size < sizeof(TextureContainerHeader)) {
+            return false;
+        }
+
+        uint32_t magic;
+        std::memcpy(&magic, data, sizeof(uint32_t));
+        return magic == TEXTURE_CONTAINER_MAGIC;
+
+    }
+
+}
@@ -0,0 +1,168 @@
+#include "TextureLoader.h"
+
+#include "TextureContainer.h"
+
+#include "stb_image.h"
+
+#include <iostream>
+
+namespace engine {
+
+    TextureLoader::~TextureLoader() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_condition.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+
+        for (auto& decodedImage : m_decodedImages) {
+            stbi_image_free(decodedImage.m_data);
+        }
+
+    }
+
+    std::shared_ptr<Texture> TextureLoader::load(const std::string& path, Callback callback, const TextureOptions& options) {
+        auto texture = std::make_shared<Texture>(options);
+        reload(texture, path, std::move(callback));
+        return texture;
+    }
+
+    void TextureLoader::reload(const std::shared_ptr<Texture>& texture, const std::string& path, Callback callback) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_running) {
+                startWorkers();
+            }
+
+            m_jobs.push_back({texture, path, std::move(callback)});
+            m_requestedCount++;
+        }
+        m_condition.notify_one();
+
+    }
+
+    void TextureLoader::processUploads() {
+
+        std::deque<DecodedImage> decodedImages;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decodedImages.empty()) {
+                return;
+            }
+            decodedImages.swap(m_decodedImages);
+        }
+
+        for (auto& decodedImage : decodedImages) {
+
+            // Nobody holds the texture anymore, so there's nothing to upload
+            auto texture = decodedImage.m_texture.lock();
+            bool loaded = false;
+
+            if (texture && decodedImage.m_container) {
+                texture->loadContainer(decodedImage.m_container->getData(), decodedImage.m_container->getSize());
+                loaded = true;
+            } else if (texture && decodedImage.m_data) {
+                texture->loadPixels((unsigned int) decodedImage.m_width, (unsigned int) decodedImage.m_height, (unsigned int) decodedImage.m_channels, decodedImage.m_data);
+                loaded = true;
+            } else if (texture) {
+                std::cout << "Failed to load texture file '" << decodedImage.m_path << "'" << std::endl;
+            }
+
+            if (texture) {
+                texture->setDebugLabel(decodedImage.m_path);
+            }
+
+            if (decodedImage.m_data) {
+                stbi_image_free(decodedImage.m_data);
+            }
+
+            if (texture && decodedImage.m_callback) {
+                decodedImage.m_callback(texture, loaded);
+            }
+
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completedCount += decodedImages.size();
+
+    }
+
+    unsigned int TextureLoader::getPendingCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_requestedCount - m_completedCount;
+    }
+
+    float TextureLoader::getProgress() {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_requestedCount == 0) {
+            return 1.0f;
+        }
+
+        return (float) m_completedCount / (float) m_requestedCount;
+
+    }
+
+    void TextureLoader::startWorkers() {
+
+        // Leave one core to the main thread
+        unsigned int coreCount = std::thread::hardware_concurrency();
+        unsigned int workerCount = coreCount > 1 ? coreCount - 1 : 1;
+
+        m_running = true;
+        for (unsigned int i = 0; i < workerCount; i++) {
+            m_workers.emplace_back(&TextureLoader::runWorker, this);
+        }
+
+    }
+
+    void TextureLoader::runWorker() {
+
+        while (true) {
+
+            Job job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() {return !m_running || !m_jobs.empty();});
+
+                if (!m_running) {
+                    return;
+                }
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            DecodedImage decodedImage = {job.m_texture, job.m_path, std::move(job.m_callback), 0, 0, 0, nullptr, nullptr};
+
+            // Skip the decoding if the texture was dropped while it was queued
+            if (!job.m_texture.expired()) {
+
+                auto file = std::make_shared<AssetFile>(job.m_path);
+
+                if (file->isOpen() && isTextureContainer(file->getData(), file->getSize())) {
+                    decodedImage.m_container = file;
+                } else if (file->isOpen()) {
+                    decodedImage.m_data = stbi_load_from_memory(file->getData(), (int) file->getSize(), &decodedImage.m_width, &decodedImage.m_height, &decodedImage.m_channels, 0);
+                }
+
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decodedImages.push_back(std::move(decodedImage));
+
+        }
+
+    }
+
+}
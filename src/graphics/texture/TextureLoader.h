@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Texture.h"
+#include "../../core/filesystem/AssetPack.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+    // Decodes texture files on worker threads, and uploads them on the main thread (the one owning the GL context)
+    class TextureLoader {
+
+    private:
+        TextureLoader() = default;
+
+    public:
+        static TextureLoader& getInstance() {
+            static TextureLoader m_instance;
+            return m_instance;
+        }
+        TextureLoader(TextureLoader const&) = delete;
+        void operator=(TextureLoader const&) = delete;
+        ~TextureLoader();
+
+        // Told whether the texture was loaded, or the file failed to load
+        using Callback = std::function<void(const std::shared_ptr<Texture>&, bool loaded)>;
+
+        // Returns an unloaded texture right away, which is bound as the placeholder until its upload
+        std::shared_ptr<Texture> load(const std::string& path, Callback callback = nullptr, const TextureOptions& options = TextureOptions());
+        // Loads into an existing texture, which keeps what it has until the upload
+        void reload(const std::shared_ptr<Texture>& texture, const std::string& path, Callback callback = nullptr);
+
+        // Uploads the decoded textures. Called once per frame, by the renderer when a scene begins
+        void processUploads();
+
+        unsigned int getPendingCount();
+        float getProgress();
+
+    private:
+
+        struct Job {
+            std::weak_ptr<Texture> m_texture;
+            std::string m_path;
+            Callback m_callback;
+        };
+
+        struct DecodedImage {
+            std::weak_ptr<Texture> m_texture;
+            std::string m_path;
+            Callback m_callback;
+            int m_width;
+            int m_height;
+            int m_channels;
+            unsigned char* m_data;
+            std::shared_ptr<AssetFile> m_container; // Pre-baked containers aren't decoded, just mapped (loose or packed)
+        };
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Job> m_jobs;
+        std::deque<DecodedImage> m_decodedImages;
+        bool m_running = false;
+
+        unsigned int m_requestedCount = 0;
+        unsigned int m_completedCount = 0;
+
+        void startWorkers();
+        void runWorker();
+
+    };
+
+}
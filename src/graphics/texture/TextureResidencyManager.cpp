@@ -0,0 +1,130 @@
+#include "TextureResidencyManager.h"
+
+#include "TextureContainer.h"
+#include "TextureLoader.h"
+#include "../../core/filesystem/AssetPack.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace engine {
+
+    void TextureResidencyManager::track(const std::shared_ptr<Texture>& texture, const std::string& path) {
+        m_entries[texture->getHandle()] = {texture, path, m_frame, false, false};
+    }
+
+    void TextureResidencyManager::touch(const Texture* texture) {
+
+        auto entry = m_entries.find(texture->getHandle());
+        if (entry == m_entries.end()) {
+            return;
+        }
+
+        entry->second.m_lastUsedFrame = m_frame;
+
+        if (!entry->second.m_evicted || entry->second.m_reloading) {
+            return;
+        }
+
+        auto trackedTexture = entry->second.m_texture.lock();
+        if (!trackedTexture) {
+            m_entries.erase(entry);
+            return;
+        }
+
+        // It keeps its low mip (or the placeholder) until the full texture is uploaded
+        entry->second.m_reloading = true;
+        TextureLoader::getInstance().reload(trackedTexture, entry->second.m_path, [this](const std::shared_ptr<Texture>& texture, bool loaded) {
+
+            auto entry = m_entries.find(texture->getHandle());
+            if (entry == m_entries.end()) {
+                return;
+            }
+
+            // A failed reload stays evicted, so the next use tries again
+            entry->second.m_evicted = !loaded;
+            entry->second.m_reloading = false;
+
+        });
+
+    }
+
+    void TextureResidencyManager::beginFrame() {
+
+        m_frame++;
+
+        size_t residentSize = 0;
+        std::vector<Entry*> candidates;
+
+        for (auto entry = m_entries.begin(); entry != m_entries.end();) {
+
+            auto texture = entry->second.m_texture.lock();
+            if (!texture) {
+                entry = m_entries.erase(entry);
+                continue;
+            }
+
+            residentSize += texture->getResidentSize();
+
+            // Textures used in the last frame will most likely be used again in this one, so they're never evicted
+            if (!entry->second.m_evicted && !entry->second.m_reloading && entry->second.m_lastUsedFrame + 1 < m_frame) {
+                candidates.push_back(&entry->second);
+            }
+
+            entry++;
+
+        }
+
+        if (residentSize <= m_budget) {
+            return;
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b) {
+            return a->m_lastUsedFrame < b->m_lastUsedFrame;
+        });
+
+        for (auto candidate : candidates) {
+
+            if (residentSize <= m_budget) {
+                break;
+            }
+
+            auto texture = candidate->m_texture.lock();
+            size_t previousSize = texture->getResidentSize();
+            evict(*candidate, *texture);
+            residentSize -= previousSize - texture->getResidentSize();
+
+        }
+
+    }
+
+    size_t TextureResidencyManager::getResidentSize() {
+
+        size_t residentSize = 0;
+        for (auto& entry : m_entries) {
+            auto texture = entry.second.m_texture.lock();
+            if (texture) {
+                residentSize += texture->getResidentSize();
+            }
+        }
+
+        return residentSize;
+
+    }
+
+    void TextureResidencyManager::evict(Entry& entry, Texture& texture) {
+
+        // Containers have their mip chain on file, so the smallest levels are cheap to keep
+        AssetFile file(entry.m_path);
+        if (file.isOpen() && isTextureContainer(file.getData(), file.getSize())) {
+            texture.loadContainer(file.getData(), file.getSize(), m_evictedDimension);
+        } else {
+            texture.unload();
+        }
+
+        entry.m_evicted = true;
+        m_evictionCount++;
+
+    }
+
+}
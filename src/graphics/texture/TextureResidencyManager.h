@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Texture.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace engine {
+
+    // Keeps the textures within a video memory budget: the least recently used ones are evicted down to a low mip
+    // (pre-baked containers) or to the placeholder (anything else), and reloaded through the TextureLoader once used again
+    class TextureResidencyManager {
+
+    private:
+        TextureResidencyManager() = default;
+
+    public:
+        static TextureResidencyManager& getInstance() {
+            static TextureResidencyManager m_instance;
+            return m_instance;
+        }
+        TextureResidencyManager(TextureResidencyManager const&) = delete;
+        void operator=(TextureResidencyManager const&) = delete;
+
+        // Only textures which can be loaded again from their file can be tracked
+        void track(const std::shared_ptr<Texture>& texture, const std::string& path);
+        // Marks the texture as used in this frame, and reloads it if it was evicted. Called by the Renderer on every bind
+        void touch(const Texture* texture);
+        // Starts a new frame, evicting textures while over the budget. Called by the Renderer at the beginning of every scene
+        void beginFrame();
+
+        inline void setBudget(size_t budget) {m_budget = budget;}
+        inline size_t getBudget() const {return m_budget;}
+        inline unsigned long getFrame() const {return m_frame;}
+        inline unsigned int getEvictionCount() const {return m_evictionCount;}
+        size_t getResidentSize();
+
+        // Evicted containers keep their levels up to this size
+        static const unsigned int m_evictedDimension = 32;
+
+    private:
+
+        struct Entry {
+            std::weak_ptr<Texture> m_texture;
+            std::string m_path;
+            unsigned long m_lastUsedFrame;
+            bool m_evicted;
+            bool m_reloading;
+        };
+
+        // By handle rather than address, so a new texture at a freed one's address doesn't inherit its entry
+        std::unordered_map<TextureHandle, Entry, HandleHash<Texture>> m_entries;
+
+        size_t m_budget = std::numeric_limits<size_t>::max();
+        unsigned long m_frame = 0;
+        unsigned int m_evictionCount = 0;
+
+        void evict(Entry& entry, Texture& texture);
+
+    };
+
+}
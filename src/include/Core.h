@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../core/utils.h" // Doesn't depend on anything
+#include "../core/filesystem/MappedFile.h" // Doesn't depend on anything
+#include "../core/filesystem/AssetPack.h" // Depends on MappedFile
+#include "../core/resource/HandlePool.h" // Doesn't depend on anything
+#include "../core/resource/BuddyAllocator.h" // Doesn't depend on anything
 
 #include "../core/input/Event.h" // Doesn't depend on anything
 #include "../core/input/events/WindowEvent.h" // Depends on Event
@@ -14,6 +18,10 @@
 #include "../core/window/Window.h" // Depends on GLFW and Events
 #include "../core/application/Application.h" // Depends on Window and EventBus
 #include "../core/render/RenderCommand.h" // Depends on RenderApi
+#include "../core/render/GpuMemoryTracker.h" // Depends on RenderApi
+#include "../core/render/RenderCommandBuffer.h" // Depends on RenderApi
+#include "../core/render/DeletionQueue.h" // Depends on RenderCommand
+#include "../core/imgui/GpuMemoryOverlay.h" // Depends on RenderCommand
 
 #include "../core/input/Input.h" // Depends on Window
 #include "../core/run-loop/RunLoop.h" // Depends on Window, Application, ImGuiRenderApi, and RenderCommand
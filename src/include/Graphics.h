@@ -6,6 +6,16 @@
 #include "../graphics/buffer/VertexBuffer.h" // Depends on BufferLayout and RenderCommand
 #include "../graphics/buffer/IndexBuffer.h" // Depends on Core/RenderCommand
 #include "../graphics/buffer/VertexArray.h" // Depends on Core/RenderCommand, VertexBuffer, and IndexBuffer
+#include "../graphics/buffer/UniformBuffer.h" // Depends on Core/RenderCommand
+#include "../graphics/buffer/PixelBufferRing.h" // Depends on Core/RenderCommand
+#include "../graphics/buffer/StreamingBuffer.h" // Depends on Core/RenderCommand
+#include "../graphics/buffer/GeometryPool.h" // Depends on Core/BuddyAllocator, Core/HandlePool, and VertexArray
 #include "../graphics/shader/Shader.h" // Depends on Core/RenderCommand
-#include "../graphics/shader/ShaderLibrary.h" // Depends on Shader
-#include "../graphics/texture/Texture.h" // Depends on STB and Core/RenderCommand
+#include "../graphics/shader/ShaderBinaryCache.h" // Depends on Shader
+#include "../graphics/shader/ShaderLibrary.h" // Depends on Shader and ShaderBinaryCache
+#include "../graphics/texture/TextureContainer.h" // Doesn't depend on anything
+#include "../graphics/texture/Texture.h" // Depends on STB, TextureContainer, and Core/RenderCommand
+#include "../graphics/texture/TextureLoader.h" // Depends on STB and Texture
+#include "../graphics/texture/TextureResidencyManager.h" // Depends on Texture and TextureLoader
+#include "../graphics/texture/TextureCache.h" // Depends on Texture, TextureLoader, and TextureResidencyManager
+#include "../graphics/texture/TextureAtlas.h" // Depends on Texture and TextureCache
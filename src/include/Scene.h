@@ -11,7 +11,11 @@
 #include "../scene/mesh/PolygonMesh.h" // Doesn't depend on anything
 #include "../scene/mesh/2d/samples/TriangleMesh.h" // Depends on PolygonMesh
 #include "../scene/mesh/2d/samples/SquareMesh.h" // Depends on PolygonMesh
+#include "../scene/mesh/MeshLibrary.h" // Depends on PolygonMesh
+#include "../scene/mesh/MeshBuilder.h" // Depends on PolygonMesh
+#include "../scene/mesh/VectorPath.h" // Depends on PolygonMesh
+#include "../scene/mesh/VectorPathCache.h" // Depends on VectorPath and MeshLibrary
 
-#include "../scene/entity/GraphicsComponents.h" // Depends on PolygonMesh and CircleMesh
+#include "../scene/entity/GraphicsComponents.h" // Depends on MeshLibrary
 #include "../scene/entity/PhysicsComponents.h" // Doesn't depend on anything
 #include "../scene/entity/ScriptComponents.h" // Depends on Entity
@@ -1,8 +1,8 @@
 #pragma once
 
-#include "../mesh/PolygonMesh.h"
-#include "../mesh/CircleMesh.h"
+#include "../mesh/MeshLibrary.h"
 #include "../../graphics/texture/Texture.h"
+#include "../../graphics/texture/TextureAtlas.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <utility>
@@ -34,16 +34,18 @@ namespace engine {
 
     };
 
+    // The geometry is shared, in the mesh library
     struct PolygonComponent {
 
         PolygonComponent() = default;
         PolygonComponent(const PolygonComponent&) = default;
-        PolygonComponent(PolygonMesh mesh) : m_mesh(std::move(mesh)) {}
+        PolygonComponent(PolygonMeshHandle mesh) : m_mesh(mesh) {}
 
-        PolygonMesh m_mesh;
+        PolygonMeshHandle m_mesh;
 
     };
 
+    // Only the parameters, every circle is drawn on the renderer's one unit quad
     struct CircleComponent {
 
         CircleComponent(const CircleComponent&) = default;
@@ -60,7 +62,6 @@ namespace engine {
             m_thickness(thickness),
             m_fade(fade) {}
 
-        CircleMesh m_mesh;
         float m_thickness;
         float m_fade;
 
@@ -69,14 +70,20 @@ namespace engine {
     struct MaterialComponent {
 
         MaterialComponent(const MaterialComponent&) = default;
-        MaterialComponent() : m_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)), m_texture(nullptr) {}
-        MaterialComponent(glm::vec4 color) : m_color(color), m_texture(nullptr) {}
-        MaterialComponent(std::shared_ptr<Texture> texture) : m_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)), m_texture(std::move(texture)) {}
-        MaterialComponent(glm::vec4 color, std::shared_ptr<Texture> texture) : m_color(color), m_texture(std::move(texture)) {}
+        MaterialComponent() : m_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)), m_texture(nullptr), m_textureCoordinatesMin(0.0f, 0.0f), m_textureCoordinatesMax(1.0f, 1.0f) {}
+        MaterialComponent(glm::vec4 color) : m_color(color), m_texture(nullptr), m_textureCoordinatesMin(0.0f, 0.0f), m_textureCoordinatesMax(1.0f, 1.0f) {}
+        MaterialComponent(std::shared_ptr<Texture> texture) : m_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)), m_texture(std::move(texture)), m_textureCoordinatesMin(0.0f, 0.0f), m_textureCoordinatesMax(1.0f, 1.0f) {}
+        MaterialComponent(glm::vec4 color, std::shared_ptr<Texture> texture) : m_color(color), m_texture(std::move(texture)), m_textureCoordinatesMin(0.0f, 0.0f), m_textureCoordinatesMax(1.0f, 1.0f) {}
+        MaterialComponent(const TextureAtlasRegion& region) : m_color(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)), m_texture(region.m_texture), m_textureCoordinatesMin(region.m_textureCoordinatesMin), m_textureCoordinatesMax(region.m_textureCoordinatesMax) {}
+        MaterialComponent(glm::vec4 color, const TextureAtlasRegion& region) : m_color(color), m_texture(region.m_texture), m_textureCoordinatesMin(region.m_textureCoordinatesMin), m_textureCoordinatesMax(region.m_textureCoordinatesMax) {}
 
         glm::vec4 m_color;
         std::shared_ptr<Texture> m_texture;
 
+        // The part of the texture the mesh's 0..1 texture coordinates span (an atlas region, or the whole texture)
+        glm::vec2 m_textureCoordinatesMin;
+        glm::vec2 m_textureCoordinatesMax;
+
     };
 
 }
\ No newline at end of file
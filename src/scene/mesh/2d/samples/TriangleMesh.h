@@ -2,6 +2,8 @@
 
 #include "../../PolygonMesh.h"
 
+#include <cmath>
+
 namespace engine {
 
     class TriangleMesh : public PolygonMesh {
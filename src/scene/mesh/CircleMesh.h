@@ -24,8 +24,8 @@ namespace engine {
 
         }
 
-        inline std::vector<CircleVertex> getVertices() const {return m_vertices;}
-        inline std::vector<unsigned int> getIndices() const {return m_indices;}
+        inline const std::vector<CircleVertex>& getVertices() const {return m_vertices;}
+        inline const std::vector<unsigned int>& getIndices() const {return m_indices;}
 
     protected:
         std::vector<CircleVertex> m_vertices = {};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../graphics/buffer/BufferLayout.h"
+
 #include "glm/glm.hpp"
 
 namespace engine {
@@ -26,4 +28,18 @@ namespace engine {
 
     };
 
+    // Attribute locations follow the order, as in the circle shaders
+    template<>
+    struct VertexLayout<CircleVertex> {
+        static constexpr VertexAttribute m_attributes[] = {
+            VERTEX_ATTRIBUTE(CircleVertex, m_position, "a_position", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_localCoordinates, "a_localCoordinates", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_thickness, "a_thickness", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_fade, "a_fade", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_textureCoordinates, "a_textureCoordinates", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_textureIndex, "a_textureIndex", VertexBufferLayoutElementType::Int, false),
+            VERTEX_ATTRIBUTE(CircleVertex, m_color, "a_color", VertexBufferLayoutElementType::Float, false)
+        };
+    };
+
 }
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "MeshBuilder.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace engine {
+
+    // Hashed and compared by bytes, which is only sound without padding
+    static_assert(sizeof(PolygonVertex) == 2 * sizeof(glm::vec4) + sizeof(glm::vec2) + sizeof(int), "PolygonVertex has padding");
+
+    static float cross(const glm::vec2& left, const glm::vec2& right) {
+        return left.x * right.y - left.y * right.x;
+    }
+
+    static bool isInsideTriangle(const glm::vec2& point, const glm::vec2& first, const glm::vec2& second, const glm::vec2& third) {
+        // On the edges counts as inside, so an ear never touches the rest of the outline
+        return cross(second - first, point - first) >= 0.0f
+            && cross(third - second, point - second) >= 0.0f
+            && cross(first - third, point - third) >= 0.0f;
+    }
+
+    // How much drawing a triangle of this vertex next would gain (as in Forsyth's linear-speed vertex cache optimization)
+    float MeshBuilder::getVertexScore(int cachePosition, unsigned int remainingTriangles) {
+
+        if (!remainingTriangles) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+
+            if (cachePosition < 3) {
+                // Used by the last triangle, so a fixed score, to avoid strips that keep reusing the same 2 vertices
+                score = 0.75f;
+            } else {
+                score = std::pow(1.0f - (float) (cachePosition - 3) / (m_vertexCacheSize - 3), 1.5f);
+            }
+
+        }
+
+        // Favor the vertices with few triangles left, so they're done with and leave the cache sooner
+        return score + 2.0f / std::sqrt((float) remainingTriangles);
+
+    }
+
+    std::size_t MeshBuilder::VertexHash::operator()(const PolygonVertex& vertex) const {
+
+        uint64_t hash = 14695981039346656037ull;
+        auto bytes = reinterpret_cast<const unsigned char*>(&vertex);
+        for (std::size_t i = 0; i < sizeof(PolygonVertex); i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+
+    }
+
+    bool MeshBuilder::VertexEqual::operator()(const PolygonVertex& left, const PolygonVertex& right) const {
+        return std::memcmp(&left, &right, sizeof(PolygonVertex)) == 0;
+    }
+
+    unsigned int MeshBuilder::addVertex(const PolygonVertex& vertex) {
+
+        auto iterator = m_vertexIndices.find(vertex);
+        if (iterator != m_vertexIndices.end()) {
+            return iterator->second;
+        }
+
+        unsigned int index = m_vertices.size();
+        m_vertices.push_back(vertex);
+        m_vertexIndices.emplace(vertex, index);
+
+        return index;
+
+    }
+
+    void MeshBuilder::addTriangle(unsigned int first, unsigned int second, unsigned int third) {
+
+        if (first >= m_vertices.size() || second >= m_vertices.size() || third >= m_vertices.size()) {
+            throw std::runtime_error("Triangle index out of range");
+        }
+
+        // Welding can collapse a triangle, which would only cost a draw for nothing
+        if (first == second || second == third || third == first) {
+            return;
+        }
+
+        m_indices.push_back(first);
+        m_indices.push_back(second);
+        m_indices.push_back(third);
+
+    }
+
+    void MeshBuilder::addTriangle(const PolygonVertex& first, const PolygonVertex& second, const PolygonVertex& third) {
+        addTriangle(addVertex(first), addVertex(second), addVertex(third));
+    }
+
+    void MeshBuilder::addPolygon(const std::vector<glm::vec2>& outline) {
+
+        if (outline.empty()) {
+            return;
+        }
+
+        glm::vec2 min = outline[0];
+        glm::vec2 max = outline[0];
+        for (auto& point : outline) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        addPolygon(outline, min, max);
+
+    }
+
+    void MeshBuilder::addPolygon(const std::vector<glm::vec2>& outline, const glm::vec2& boundsMin, const glm::vec2& boundsMax) {
+
+        unsigned int pointCount = outline.size();
+        if (pointCount < 3) {
+            return;
+        }
+
+        // The winding, from the signed area
+        float area = 0.0f;
+        for (unsigned int i = 0; i < pointCount; i++) {
+            area += cross(outline[i], outline[(i + 1) % pointCount]);
+        }
+
+        glm::vec2 min = boundsMin;
+        glm::vec2 size = boundsMax - boundsMin;
+        size.x = size.x > 0.0f ? size.x : 1.0f;
+        size.y = size.y > 0.0f ? size.y : 1.0f;
+
+        // Walked counter-clockwise, whatever the outline's winding, so the triangles always face the same way
+        std::vector<glm::vec2> points(pointCount);
+        std::vector<unsigned int> indices(pointCount);
+        for (unsigned int i = 0; i < pointCount; i++) {
+            const glm::vec2& point = outline[area < 0.0f ? pointCount - 1 - i : i];
+            points[i] = point;
+            indices[i] = addVertex(PolygonVertex({point.x, point.y, 0.0f, 1.0f}, (point - min) / size));
+        }
+
+        // The outline left to clip, as a circular linked list
+        std::vector<unsigned int> previous(pointCount);
+        std::vector<unsigned int> next(pointCount);
+        for (unsigned int i = 0; i < pointCount; i++) {
+            previous[i] = (i + pointCount - 1) % pointCount;
+            next[i] = (i + 1) % pointCount;
+        }
+
+        unsigned int current = 0;
+        unsigned int remainingCount = pointCount;
+        unsigned int attemptCount = 0; // Since the last ear, a whole lap without one means the outline isn't simple
+
+        while (remainingCount > 3) {
+
+            if (attemptCount > remainingCount) {
+                throw std::runtime_error("Couldn't triangulate the polygon, its outline isn't simple");
+            }
+
+            unsigned int first = previous[current];
+            unsigned int third = next[current];
+            float turn = cross(points[current] - points[first], points[third] - points[current]);
+
+            // A convex corner is an ear if no other point is inside it. Collinear points are dropped without a triangle
+            bool ear = turn >= 0.0f;
+            if (turn > 0.0f) {
+                for (unsigned int point = next[third]; point != first; point = next[point]) {
+                    if (isInsideTriangle(points[point], points[first], points[current], points[third])) {
+                        ear = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!ear) {
+                current = next[current];
+                attemptCount++;
+                continue;
+            }
+
+            if (turn > 0.0f) {
+                addTriangle(indices[first], indices[current], indices[third]);
+            }
+
+            next[first] = third;
+            previous[third] = first;
+            remainingCount--;
+            attemptCount = 0;
+
+            // Clipping can turn the previous corner into an ear
+            current = first;
+
+        }
+
+        unsigned int first = previous[current];
+        unsigned int third = next[current];
+        if (cross(points[current] - points[first], points[third] - points[current]) > 0.0f) {
+            addTriangle(indices[first], indices[current], indices[third]);
+        }
+
+    }
+
+    PolygonMesh MeshBuilder::build() const {
+
+        std::vector<unsigned int> triangleOrder = optimizeTriangleOrder();
+
+        // Renumber the vertices in the order the triangles first use them, so they're read sequentially and unused ones are left out
+        std::vector<int> vertexRemap(m_vertices.size(), -1);
+        std::vector<PolygonVertex> vertices;
+        std::vector<unsigned int> indices;
+        vertices.reserve(m_vertices.size());
+        indices.reserve(m_indices.size());
+
+        for (auto triangle : triangleOrder) {
+            for (unsigned int corner = 0; corner < 3; corner++) {
+
+                unsigned int index = m_indices[triangle * 3 + corner];
+                if (vertexRemap[index] < 0) {
+                    vertexRemap[index] = (int) vertices.size();
+                    vertices.push_back(m_vertices[index]);
+                }
+
+                indices.push_back(vertexRemap[index]);
+
+            }
+        }
+
+        return PolygonMesh(std::move(vertices), std::move(indices));
+
+    }
+
+    void MeshBuilder::clear() {
+        m_vertices.clear();
+        m_indices.clear();
+        m_vertexIndices.clear();
+    }
+
+    std::vector<unsigned int> MeshBuilder::optimizeTriangleOrder() const {
+
+        unsigned int vertexCount = m_vertices.size();
+        unsigned int triangleCount = m_indices.size() / 3;
+
+        // The triangles of every vertex, packed: vertex i's are at [triangleOffsets[i], triangleOffsets[i + 1])
+        std::vector<unsigned int> remainingTriangles(vertexCount, 0);
+        for (auto index : m_indices) {
+            remainingTriangles[index]++;
+        }
+
+        std::vector<unsigned int> triangleOffsets(vertexCount + 1, 0);
+        for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+            triangleOffsets[vertex + 1] = triangleOffsets[vertex] + remainingTriangles[vertex];
+        }
+
+        std::vector<unsigned int> vertexTriangles(m_indices.size());
+        std::vector<unsigned int> filled(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (unsigned int triangle = 0; triangle < triangleCount; triangle++) {
+            for (unsigned int corner = 0; corner < 3; corner++) {
+                unsigned int vertex = m_indices[triangle * 3 + corner];
+                vertexTriangles[filled[vertex]++] = triangle;
+            }
+        }
+
+        std::vector<int> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (unsigned int vertex = 0; vertex < vertexCount; vertex++) {
+            vertexScores[vertex] = getVertexScore(-1, remainingTriangles[vertex]);
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<unsigned int> cache; // Most recently used first
+        std::vector<unsigned int> nextCache;
+        std::vector<unsigned int> order;
+        order.reserve(triangleCount);
+        unsigned int firstUnemitted = 0;
+
+        while (order.size() < triangleCount) {
+
+            // The best triangle using a cached vertex, or else the first one left, to start somewhere new
+            int best = -1;
+            float bestScore = -1.0f;
+            for (auto vertex : cache) {
+                for (unsigned int i = triangleOffsets[vertex]; i < triangleOffsets[vertex + 1]; i++) {
+
+                    unsigned int triangle = vertexTriangles[i];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+
+                    const unsigned int* corners = &m_indices[triangle * 3];
+                    float score = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+                    if (score > bestScore) {
+                        best = (int) triangle;
+                        bestScore = score;
+                    }
+
+                }
+            }
+
+            if (best < 0) {
+                while (emitted[firstUnemitted]) {
+                    firstUnemitted++;
+                }
+                best = (int) firstUnemitted;
+            }
+
+            emitted[best] = true;
+            order.push_back(best);
+
+            // The triangle's vertices move to the front of the cache, pushing the rest back
+            const unsigned int* corners = &m_indices[best * 3];
+            nextCache.assign(corners, corners + 3);
+            for (unsigned int corner = 0; corner < 3; corner++) {
+                remainingTriangles[corners[corner]]--;
+            }
+
+            for (auto vertex : cache) {
+                if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                    nextCache.push_back(vertex);
+                }
+            }
+
+            for (unsigned int position = 0; position < nextCache.size(); position++) {
+
+                unsigned int vertex = nextCache[position];
+                cachePositions[vertex] = position < m_vertexCacheSize ? (int) position : -1;
+                vertexScores[vertex] = getVertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+
+            }
+
+            if (nextCache.size() > m_vertexCacheSize) {
+                nextCache.resize(m_vertexCacheSize);
+            }
+
+            std::swap(cache, nextCache);
+
+        }
+
+        return order;
+
+    }
+
+}
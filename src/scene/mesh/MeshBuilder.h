@@ -0,0 +1,56 @@
+#pragma once
+
+#include "PolygonMesh.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+    // Builds indexed polygon meshes out of triangles and outlines. Identical vertices are welded as they're added, and
+    // build() reorders the triangles for the post-transform vertex cache, then the vertices by first use, so the mesh
+    // comes out compact and cache friendly
+    class MeshBuilder {
+
+    public:
+        // Returns the index of the vertex, the existing one if an identical vertex was added already
+        unsigned int addVertex(const PolygonVertex& vertex);
+        void addTriangle(unsigned int first, unsigned int second, unsigned int third);
+        void addTriangle(const PolygonVertex& first, const PolygonVertex& second, const PolygonVertex& third);
+        // Triangulates a simple polygon (no holes or self-intersections, either winding) by ear clipping, at z = 0
+        // The texture coordinates span the outline's bounding box, from 0 to 1, or the given bounds
+        void addPolygon(const std::vector<glm::vec2>& outline);
+        void addPolygon(const std::vector<glm::vec2>& outline, const glm::vec2& boundsMin, const glm::vec2& boundsMax);
+
+        PolygonMesh build() const;
+        void clear();
+
+        inline unsigned int getVertexCount() const {return m_vertices.size();}
+        inline unsigned int getTriangleCount() const {return m_indices.size() / 3;}
+
+    private:
+
+        struct VertexHash {
+            std::size_t operator()(const PolygonVertex& vertex) const;
+        };
+
+        struct VertexEqual {
+            bool operator()(const PolygonVertex& left, const PolygonVertex& right) const;
+        };
+
+        static const unsigned int m_vertexCacheSize = 32; // The post-transform cache ordered for, most GPUs have at least this many entries
+
+        std::vector<PolygonVertex> m_vertices;
+        std::vector<unsigned int> m_indices;
+        std::unordered_map<PolygonVertex, unsigned int, VertexHash, VertexEqual> m_vertexIndices;
+
+        // The triangles (indices into m_indices / 3), in the order that reuses the most vertices from the cache
+        std::vector<unsigned int> optimizeTriangleOrder() const;
+        static float getVertexScore(int cachePosition, unsigned int remainingTriangles);
+
+    };
+
+}
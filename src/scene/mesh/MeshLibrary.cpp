@@ -0,0 +1,38 @@
+#include "MeshLibrary.h"
+
+#include "2d/samples/SquareMesh.h"
+#include "2d/samples/TriangleMesh.h"
+
+#include <utility>
+
+namespace engine {
+
+    PolygonMeshHandle MeshLibrary::add(PolygonMesh mesh) {
+        return m_meshes.insert(std::move(mesh));
+    }
+
+    void MeshLibrary::remove(PolygonMeshHandle handle) {
+        m_meshes.release(handle);
+    }
+
+    PolygonMeshHandle MeshLibrary::getSquare() {
+
+        if (!m_meshes.isValid(m_square)) {
+            m_square = add(SquareMesh());
+        }
+
+        return m_square;
+
+    }
+
+    PolygonMeshHandle MeshLibrary::getTriangle() {
+
+        if (!m_meshes.isValid(m_triangle)) {
+            m_triangle = add(TriangleMesh());
+        }
+
+        return m_triangle;
+
+    }
+
+}
\ No newline at end of file
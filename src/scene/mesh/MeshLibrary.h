@@ -0,0 +1,43 @@
+#pragma once
+
+#include "PolygonMesh.h"
+#include "../../core/resource/HandlePool.h"
+
+namespace engine {
+
+    using PolygonMeshHandle = Handle<PolygonMesh>;
+
+    // Owns the polygon meshes, immutable once added, so any number of components can share one by handle instead of
+    // each carrying its own copy of the geometry. A mesh lives until it's removed, its handles resolve to nothing then
+    // Not thread-safe: meshes are only added and removed on the main thread
+    class MeshLibrary {
+
+    private:
+        MeshLibrary() = default;
+
+    public:
+        static MeshLibrary& getInstance() {
+            static MeshLibrary m_instance;
+            return m_instance;
+        }
+        MeshLibrary(MeshLibrary const&) = delete;
+        void operator=(MeshLibrary const&) = delete;
+
+        PolygonMeshHandle add(PolygonMesh mesh);
+        void remove(PolygonMeshHandle handle);
+        // Returns nullptr for stale handles. Only valid until the next mesh is added
+        inline const PolygonMesh* get(PolygonMeshHandle handle) {return m_meshes.get(handle);}
+        inline unsigned int getMeshCount() const {return m_meshes.getSize();}
+
+        // The sample meshes, added on first use
+        PolygonMeshHandle getSquare();
+        PolygonMeshHandle getTriangle();
+
+    private:
+        HandlePool<PolygonMesh> m_meshes;
+        PolygonMeshHandle m_square;
+        PolygonMeshHandle m_triangle;
+
+    };
+
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "PolygonVertex.h"
 
+#include <utility>
 #include <vector>
 
 namespace engine {
@@ -11,9 +12,10 @@ namespace engine {
     public:
 
         PolygonMesh() : m_vertices({}), m_indices({}) {}
+        PolygonMesh(std::vector<PolygonVertex> vertices, std::vector<unsigned int> indices) : m_vertices(std::move(vertices)), m_indices(std::move(indices)) {}
 
-        inline std::vector<PolygonVertex> getVertices() const {return m_vertices;}
-        inline std::vector<unsigned int> getIndices() const {return m_indices;}
+        inline const std::vector<PolygonVertex>& getVertices() const {return m_vertices;}
+        inline const std::vector<unsigned int>& getIndices() const {return m_indices;}
 
     protected:
         std::vector<PolygonVertex> m_vertices = {};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../graphics/buffer/BufferLayout.h"
+
 #include "glm/glm.hpp"
 
 namespace engine {
@@ -20,4 +22,15 @@ namespace engine {
 
     };
 
+    // Attribute locations follow the order, as in the polygon shaders
+    template<>
+    struct VertexLayout<PolygonVertex> {
+        static constexpr VertexAttribute m_attributes[] = {
+            VERTEX_ATTRIBUTE(PolygonVertex, m_position, "a_position", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(PolygonVertex, m_textureCoordinates, "a_textureCoordinates", VertexBufferLayoutElementType::Float, false),
+            VERTEX_ATTRIBUTE(PolygonVertex, m_textureIndex, "a_textureIndex", VertexBufferLayoutElementType::Int, false),
+            VERTEX_ATTRIBUTE(PolygonVertex, m_color, "a_color", VertexBufferLayoutElementType::Float, false)
+        };
+    };
+
 }
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include "VectorPath.h"
+
+#include "MeshBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace engine {
+
+    static float cross(const glm::vec2& left, const glm::vec2& right) {
+        return left.x * right.y - left.y * right.x;
+    }
+
+    // How many lines a curve needs to stay within the tolerance (Wang's formula), given its largest second difference
+    static unsigned int getSegmentCount(float factor, float secondDifference, float scale, float tolerance) {
+        float count = std::ceil(std::sqrt(factor * secondDifference * scale / tolerance));
+        return (unsigned int) std::min(std::max(count, 1.0f), 1024.0f);
+    }
+
+    static bool isOnSegment(const glm::vec2& point, const glm::vec2& start, const glm::vec2& end) {
+        return point.x >= std::min(start.x, end.x) && point.x <= std::max(start.x, end.x)
+            && point.y >= std::min(start.y, end.y) && point.y <= std::max(start.y, end.y);
+    }
+
+    // Touching counts, since ear clipping can't get past it either
+    static bool doSegmentsIntersect(const glm::vec2& firstStart, const glm::vec2& firstEnd, const glm::vec2& secondStart, const glm::vec2& secondEnd) {
+
+        float firstSide = cross(firstEnd - firstStart, secondStart - firstStart);
+        float secondSide = cross(firstEnd - firstStart, secondEnd - firstStart);
+        float thirdSide = cross(secondEnd - secondStart, firstStart - secondStart);
+        float fourthSide = cross(secondEnd - secondStart, firstEnd - secondStart);
+
+        if (((firstSide > 0.0f && secondSide < 0.0f) || (firstSide < 0.0f && secondSide > 0.0f))
+            && ((thirdSide > 0.0f && fourthSide < 0.0f) || (thirdSide < 0.0f && fourthSide > 0.0f))) {
+            return true;
+        }
+
+        return (firstSide == 0.0f && isOnSegment(secondStart, firstStart, firstEnd))
+            || (secondSide == 0.0f && isOnSegment(secondEnd, firstStart, firstEnd))
+            || (thirdSide == 0.0f && isOnSegment(firstStart, secondStart, secondEnd))
+            || (fourthSide == 0.0f && isOnSegment(firstEnd, secondStart, secondEnd));
+
+    }
+
+    // Whether two segments of the outline (closed) cross or touch, other than neighbours at their shared point
+    // The segments are swept by their left end, so only the ones overlapping along x are compared
+    static bool isSelfIntersecting(const std::vector<glm::vec2>& outline) {
+
+        unsigned int segmentCount = outline.size();
+        if (segmentCount < 4) {
+            return false;
+        }
+
+        std::vector<unsigned int> order(segmentCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](unsigned int left, unsigned int right) {
+            return std::min(outline[left].x, outline[(left + 1) % segmentCount].x) < std::min(outline[right].x, outline[(right + 1) % segmentCount].x);
+        });
+
+        for (unsigned int i = 0; i < segmentCount; i++) {
+
+            unsigned int first = order[i];
+            const glm::vec2& firstStart = outline[first];
+            const glm::vec2& firstEnd = outline[(first + 1) % segmentCount];
+            float firstMaxX = std::max(firstStart.x, firstEnd.x);
+
+            for (unsigned int j = i + 1; j < segmentCount; j++) {
+
+                unsigned int second = order[j];
+                const glm::vec2& secondStart = outline[second];
+                const glm::vec2& secondEnd = outline[(second + 1) % segmentCount];
+                if (std::min(secondStart.x, secondEnd.x) > firstMaxX) {
+                    break;
+                }
+
+                bool neighbours = (first + 1) % segmentCount == second || (second + 1) % segmentCount == first;
+                if (!neighbours && doSegmentsIntersect(firstStart, firstEnd, secondStart, secondEnd)) {
+                    return true;
+                }
+
+            }
+
+        }
+
+        return false;
+
+    }
+
+    static PolygonVertex getVertex(const glm::vec2& point, const glm::vec2& boundsMin, const glm::vec2& boundsSize) {
+        return PolygonVertex({point.x, point.y, 0.0f, 1.0f}, (point - boundsMin) / boundsSize);
+    }
+
+    // Counter-clockwise, like the filled triangles
+    static void addTriangle(MeshBuilder& builder, const glm::vec2& first, const glm::vec2& second, const glm::vec2& third, const glm::vec2& boundsMin, const glm::vec2& boundsSize) {
+
+        if (cross(second - first, third - first) < 0.0f) {
+            builder.addTriangle(getVertex(first, boundsMin, boundsSize), getVertex(third, boundsMin, boundsSize), getVertex(second, boundsMin, boundsSize));
+        } else {
+            builder.addTriangle(getVertex(first, boundsMin, boundsSize), getVertex(second, boundsMin, boundsSize), getVertex(third, boundsMin, boundsSize));
+        }
+
+    }
+
+    static void addStroke(MeshBuilder& builder, const std::vector<glm::vec2>& polyline, bool closed, float halfWidth, const glm::vec2& boundsMin, const glm::vec2& boundsSize) {
+
+        unsigned int pointCount = polyline.size();
+        unsigned int segmentCount = closed ? pointCount : pointCount - 1;
+
+        // A quad along every segment, offset by half the width to both sides
+        std::vector<glm::vec2> offsets(segmentCount);
+        for (unsigned int i = 0; i < segmentCount; i++) {
+
+            const glm::vec2& start = polyline[i];
+            const glm::vec2& end = polyline[(i + 1) % pointCount];
+            glm::vec2 direction = (end - start) / glm::length(end - start);
+            offsets[i] = glm::vec2(-direction.y, direction.x) * halfWidth;
+
+            addTriangle(builder, start - offsets[i], end - offsets[i], end + offsets[i], boundsMin, boundsSize);
+            addTriangle(builder, end + offsets[i], start + offsets[i], start - offsets[i], boundsMin, boundsSize);
+
+        }
+
+        // And a triangle filling the gap on the outer side of every corner
+        unsigned int firstCorner = closed ? 0 : 1;
+        unsigned int lastCorner = closed ? pointCount : pointCount - 1;
+        for (unsigned int corner = firstCorner; corner < lastCorner; corner++) {
+
+            const glm::vec2& point = polyline[corner];
+            const glm::vec2& previousOffset = offsets[(corner + segmentCount - 1) % segmentCount];
+            const glm::vec2& nextOffset = offsets[corner % segmentCount];
+
+            float turn = cross(previousOffset, nextOffset);
+            if (turn > 0.0f) {
+                addTriangle(builder, point, point - previousOffset, point - nextOffset, boundsMin, boundsSize);
+            } else if (turn < 0.0f) {
+                addTriangle(builder, point, point + previousOffset, point + nextOffset, boundsMin, boundsSize);
+            }
+
+        }
+
+    }
+
+    VectorPath& VectorPath::moveTo(const glm::vec2& point) {
+        append(PathCommand::MoveTo, &point, 1);
+        return *this;
+    }
+
+    VectorPath& VectorPath::lineTo(const glm::vec2& point) {
+        append(PathCommand::LineTo, &point, 1);
+        return *this;
+    }
+
+    VectorPath& VectorPath::quadTo(const glm::vec2& control, const glm::vec2& point) {
+        glm::vec2 points[2] = {control, point};
+        append(PathCommand::QuadTo, points, 2);
+        return *this;
+    }
+
+    VectorPath& VectorPath::cubicTo(const glm::vec2& firstControl, const glm::vec2& secondControl, const glm::vec2& point) {
+        glm::vec2 points[3] = {firstControl, secondControl, point};
+        append(PathCommand::CubicTo, points, 3);
+        return *this;
+    }
+
+    VectorPath& VectorPath::close() {
+        append(PathCommand::Close, nullptr, 0);
+        return *this;
+    }
+
+    VectorPath& VectorPath::roundedRectangle(const glm::vec2& min, const glm::vec2& max, float radius) {
+
+        radius = std::max(0.0f, std::min(radius, std::min(max.x - min.x, max.y - min.y) / 2.0f));
+        float control = radius * (1.0f - m_circleControlDistance); // From the corner
+
+        moveTo({min.x + radius, min.y});
+        lineTo({max.x - radius, min.y});
+        cubicTo({max.x - control, min.y}, {max.x, min.y + control}, {max.x, min.y + radius});
+        lineTo({max.x, max.y - radius});
+        cubicTo({max.x, max.y - control}, {max.x - control, max.y}, {max.x - radius, max.y});
+        lineTo({min.x + radius, max.y});
+        cubicTo({min.x + control, max.y}, {min.x, max.y - control}, {min.x, max.y - radius});
+        lineTo({min.x, min.y + radius});
+        cubicTo({min.x, min.y + control}, {min.x + control, min.y}, {min.x + radius, min.y});
+
+        return close();
+
+    }
+
+    PolygonMesh VectorPath::tessellate(const PathStyle& style, float scale) const {
+        bool outlined;
+        return tessellate(style, scale, outlined);
+    }
+
+    PolygonMesh VectorPath::tessellate(const PathStyle& style, float scale, bool& outlined) const {
+
+        outlined = false;
+
+        std::vector<std::vector<glm::vec2>> polylines;
+        std::vector<bool> closed;
+        flatten(scale, polylines, closed);
+
+        MeshBuilder builder;
+        if (polylines.empty()) {
+            return builder.build();
+        }
+
+        // The texture coordinates span the whole path, including the stroke
+        float halfWidth = style.m_strokeWidth / 2.0f;
+        glm::vec2 min = polylines[0][0];
+        glm::vec2 max = polylines[0][0];
+        for (auto& polyline : polylines) {
+            for (auto& point : polyline) {
+                min = glm::min(min, point);
+                max = glm::max(max, point);
+            }
+        }
+
+        min = min - glm::vec2(halfWidth);
+        max = max + glm::vec2(halfWidth);
+        glm::vec2 size = max - min;
+        size.x = size.x > 0.0f ? size.x : 1.0f;
+        size.y = size.y > 0.0f ? size.y : 1.0f;
+
+        // Only simple outlines can be filled, the rest are outlined instead, by the stroke or else a hairline
+        std::vector<bool> outlinedPolylines(polylines.size(), false);
+        if (style.m_fill) {
+            for (unsigned int i = 0; i < polylines.size(); i++) {
+
+                if (isSelfIntersecting(polylines[i])) {
+                    outlinedPolylines[i] = true;
+                    continue;
+                }
+
+                // Ear clipping can still fail on an outline that nearly intersects itself, keeping the triangles made before that
+                try {
+                    builder.addPolygon(polylines[i], min, max);
+                } catch (const std::runtime_error&) {
+                    outlinedPolylines[i] = true;
+                }
+
+            }
+        }
+
+        for (unsigned int i = 0; i < polylines.size(); i++) {
+            outlined = outlined || outlinedPolylines[i];
+            if (halfWidth > 0.0f) {
+                addStroke(builder, polylines[i], closed[i], halfWidth, min, size);
+            } else if (outlinedPolylines[i]) {
+                addStroke(builder, polylines[i], true, m_hairlineWidth / scale / 2.0f, min, size);
+            }
+        }
+
+        return builder.build();
+
+    }
+
+    bool VectorPath::operator==(const VectorPath& other) const {
+        return m_hash == other.m_hash && m_commands == other.m_commands && m_points == other.m_points;
+    }
+
+    void VectorPath::append(PathCommand command, const glm::vec2* points, unsigned int count) {
+
+        m_commands.push_back(command);
+        m_points.insert(m_points.end(), points, points + count);
+
+        // FNV-1a, over the command and the bytes of its points
+        auto combine = [this](const void* data, std::size_t size) {
+            auto bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; i++) {
+                m_hash ^= bytes[i];
+                m_hash *= 1099511628211ull;
+            }
+        };
+
+        combine(&command, sizeof(PathCommand));
+        combine(points, count * sizeof(glm::vec2));
+
+    }
+
+    void VectorPath::flatten(float scale, std::vector<std::vector<glm::vec2>>& polylines, std::vector<bool>& closed) const {
+
+        glm::vec2 current(0.0f, 0.0f);
+        glm::vec2 start(0.0f, 0.0f);
+        bool drawing = false; // Whether the last polyline is still being added to
+
+        // A subpath only starts with its first segment, so a lone move doesn't leave a point behind
+        auto addPoint = [&](const glm::vec2& point) {
+
+            if (!drawing) {
+                polylines.push_back({current});
+                closed.push_back(false);
+                drawing = true;
+            }
+
+            if (!(polylines.back().back() == point)) {
+                polylines.back().push_back(point);
+            }
+
+        };
+
+        unsigned int pointIndex = 0;
+        for (auto command : m_commands) {
+
+            switch (command) {
+
+                case PathCommand::MoveTo:
+                    current = start = m_points[pointIndex++];
+                    drawing = false;
+                    break;
+
+                case PathCommand::LineTo:
+                    addPoint(m_points[pointIndex]);
+                    current = m_points[pointIndex++];
+                    break;
+
+                case PathCommand::QuadTo: {
+
+                    const glm::vec2& control = m_points[pointIndex];
+                    const glm::vec2& end = m_points[pointIndex + 1];
+                    pointIndex += 2;
+
+                    unsigned int segmentCount = getSegmentCount(0.25f, glm::length(current - control * 2.0f + end), scale, m_tolerance);
+                    for (unsigned int i = 1; i <= segmentCount; i++) {
+                        float t = (float) i / segmentCount;
+                        float u = 1.0f - t;
+                        addPoint(current * (u * u) + control * (2.0f * u * t) + end * (t * t));
+                    }
+
+                    current = end;
+                    break;
+
+                }
+
+                case PathCommand::CubicTo: {
+
+                    const glm::vec2& firstControl = m_points[pointIndex];
+                    const glm::vec2& secondControl = m_points[pointIndex + 1];
+                    const glm::vec2& end = m_points[pointIndex + 2];
+                    pointIndex += 3;
+
+                    float secondDifference = std::max(glm::length(current - firstControl * 2.0f + secondControl), glm::length(firstControl - secondControl * 2.0f + end));
+                    unsigned int segmentCount = getSegmentCount(0.75f, secondDifference, scale, m_tolerance);
+                    for (unsigned int i = 1; i <= segmentCount; i++) {
+                        float t = (float) i / segmentCount;
+                        float u = 1.0f - t;
+                        addPoint(current * (u * u * u) + firstControl * (3.0f * u * u * t) + secondControl * (3.0f * u * t * t) + end * (t * t * t));
+                    }
+
+                    current = end;
+                    break;
+
+                }
+
+                case PathCommand::Close:
+
+                    // The closing segment is implied, so the polyline doesn't repeat its first point
+                    if (drawing) {
+                        auto& polyline = polylines.back();
+                        if (polyline.size() > 1 && polyline.back() == polyline.front()) {
+                            polyline.pop_back();
+                        }
+                        closed.back() = polyline.size() > 2;
+                    }
+
+                    current = start;
+                    drawing = false;
+                    break;
+
+            }
+
+        }
+
+        // A subpath has to span a segment at least
+        for (unsigned int i = polylines.size(); i-- > 0;) {
+            if (polylines[i].size() < 2) {
+                polylines.erase(polylines.begin() + i);
+                closed.erase(closed.begin() + i);
+            }
+        }
+
+    }
+
+}
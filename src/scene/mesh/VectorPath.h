@@ -0,0 +1,64 @@
+#pragma once
+
+#include "PolygonMesh.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+    enum class PathCommand {
+        MoveTo,
+        LineTo,
+        QuadTo,
+        CubicTo,
+        Close
+    };
+
+    struct PathStyle {
+        bool m_fill = true;
+        float m_strokeWidth = 0.0f; // In path units, 0 for no stroke
+    };
+
+    // An outline of lines and Bézier curves, tessellated into polygon mesh triangles
+    // Every subpath is filled on its own, as a simple polygon (no holes), and stroked with bevel joins and butt caps
+    // A self-intersecting subpath can't be filled, so it's outlined instead
+    class VectorPath {
+
+    private:
+        std::vector<PathCommand> m_commands;
+        std::vector<glm::vec2> m_points; // 1 per move and line, 2 per quadratic curve, 3 per cubic curve
+        uint64_t m_hash = 14695981039346656037ull; // Kept up to date as the path is built
+
+    public:
+        VectorPath& moveTo(const glm::vec2& point);
+        VectorPath& lineTo(const glm::vec2& point);
+        VectorPath& quadTo(const glm::vec2& control, const glm::vec2& point);
+        VectorPath& cubicTo(const glm::vec2& firstControl, const glm::vec2& secondControl, const glm::vec2& point);
+        VectorPath& close();
+        // A closed subpath, with its corners rounded by quarter circles of the given radius
+        VectorPath& roundedRectangle(const glm::vec2& min, const glm::vec2& max, float radius);
+
+        // The scale is how many pixels a path unit covers on screen, the curves are flattened to within a fraction of a pixel at it
+        PolygonMesh tessellate(const PathStyle& style, float scale) const;
+        // Sets outlined if a fill couldn't be filled, and was outlined instead
+        PolygonMesh tessellate(const PathStyle& style, float scale, bool& outlined) const;
+
+        bool operator==(const VectorPath& other) const;
+        inline uint64_t getHash() const {return m_hash;}
+        inline bool isEmpty() const {return m_commands.empty();}
+
+    private:
+        static constexpr float m_tolerance = 0.25f; // In pixels
+        static constexpr float m_hairlineWidth = 1.0f; // In pixels, for outlining what can't be filled and has no stroke
+        static constexpr float m_circleControlDistance = 0.5522847f; // The cubic control point distance closest to a quarter circle, relative to the radius
+
+        void append(PathCommand command, const glm::vec2* points, unsigned int count);
+        // Every subpath as a polyline, without repeated points, and whether it's closed
+        void flatten(float scale, std::vector<std::vector<glm::vec2>>& polylines, std::vector<bool>& closed) const;
+
+    };
+
+}
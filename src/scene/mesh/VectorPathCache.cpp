@@ -0,0 +1,135 @@
+#include "VectorPathCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace engine {
+
+    PolygonMeshHandle VectorPathCache::get(const VectorPath& path, const PathStyle& style, float scale) {
+
+        int scaleBucket = getScaleBucket(scale);
+        auto& entries = m_entries[getKey(path, style, scaleBucket)];
+
+        for (auto& entry : entries) {
+
+            if (entry.m_scaleBucket != scaleBucket || entry.m_style.m_fill != style.m_fill || entry.m_style.m_strokeWidth != style.m_strokeWidth || !(entry.m_path == path)) {
+                continue;
+            }
+
+            // Tessellated again if the mesh was removed from the library behind the cache's back
+            if (!MeshLibrary::getInstance().get(entry.m_mesh)) {
+                m_missCount++;
+                m_lastUsedFrames.erase(entry.m_mesh);
+                entry.m_mesh = tessellate(path, style, scaleBucket);
+                m_lastUsedFrames[entry.m_mesh] = m_frame;
+                return entry.m_mesh;
+            }
+
+            m_hitCount++;
+            m_lastUsedFrames[entry.m_mesh] = m_frame;
+            return entry.m_mesh;
+
+        }
+
+        m_missCount++;
+        m_entryCount++;
+        PolygonMeshHandle mesh = tessellate(path, style, scaleBucket);
+        entries.push_back({path, style, scaleBucket, mesh});
+        m_lastUsedFrames[mesh] = m_frame;
+
+        return mesh;
+
+    }
+
+    void VectorPathCache::touch(PolygonMeshHandle mesh) {
+
+        // Meshes the cache doesn't own are left alone
+        auto lastUsedFrame = m_lastUsedFrames.find(mesh);
+        if (lastUsedFrame != m_lastUsedFrames.end()) {
+            lastUsedFrame->second = m_frame;
+        }
+
+    }
+
+    void VectorPathCache::beginFrame() {
+
+        m_frame++;
+
+        for (auto bucket = m_entries.begin(); bucket != m_entries.end();) {
+
+            auto& entries = bucket->second;
+            for (unsigned int i = entries.size(); i-- > 0;) {
+                auto lastUsedFrame = m_lastUsedFrames.find(entries[i].m_mesh);
+                if (lastUsedFrame->second + m_maxUnusedFrames < m_frame) {
+                    MeshLibrary::getInstance().remove(entries[i].m_mesh);
+                    m_lastUsedFrames.erase(lastUsedFrame);
+                    entries.erase(entries.begin() + i);
+                    m_entryCount--;
+                }
+            }
+
+            if (entries.empty()) {
+                bucket = m_entries.erase(bucket);
+            } else {
+                bucket++;
+            }
+
+        }
+
+    }
+
+    void VectorPathCache::clear() {
+
+        for (auto& [key, entries] : m_entries) {
+            for (auto& entry : entries) {
+                MeshLibrary::getInstance().remove(entry.m_mesh);
+            }
+        }
+
+        m_entries.clear();
+        m_lastUsedFrames.clear();
+        m_outlinedPaths.clear();
+        m_entryCount = 0;
+
+    }
+
+    PolygonMeshHandle VectorPathCache::tessellate(const VectorPath& path, const PathStyle& style, int scaleBucket) {
+
+        bool outlined;
+        PolygonMeshHandle mesh = MeshLibrary::getInstance().add(path.tessellate(style, std::exp2(scaleBucket / 2.0f), outlined));
+
+        // Reported once per path, not again for every scale it's tessellated at
+        if (outlined && m_outlinedPaths.insert(path.getHash()).second) {
+            std::cout << "Can't fill a self-intersecting path, outlining it instead" << std::endl;
+        }
+
+        return mesh;
+
+    }
+
+    int VectorPathCache::getScaleBucket(float scale) {
+        // Rounded up, so a tessellation is never coarser than its scale needs
+        return (int) std::ceil(std::log2(std::max(scale, 1e-6f)) * 2.0f);
+    }
+
+    uint64_t VectorPathCache::getKey(const VectorPath& path, const PathStyle& style, int scaleBucket) {
+
+        uint64_t key = path.getHash();
+        auto combine = [&key](uint64_t value) {
+            key ^= value + 0x9e3779b97f4a7c15 + (key << 6) + (key >> 2);
+        };
+
+        uint32_t strokeWidth;
+        std::memcpy(&strokeWidth, &style.m_strokeWidth, sizeof(float));
+
+        combine(style.m_fill);
+        combine(strokeWidth);
+        combine((uint32_t) scaleBucket);
+
+        return key;
+
+    }
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "VectorPath.h"
+#include "MeshLibrary.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace engine {
+
+    // Shares the tessellations of vector paths by path, style and scale bucket, so a path that doesn't change is only
+    // tessellated once, not every frame. The meshes are in the mesh library, ready for polygon components, until
+    // they go neither looked up nor drawn for a while
+    // Not thread-safe: paths are only tessellated on the main thread
+    class VectorPathCache {
+
+    private:
+        VectorPathCache() = default;
+
+    public:
+        static VectorPathCache& getInstance() {
+            static VectorPathCache m_instance;
+            return m_instance;
+        }
+        VectorPathCache(VectorPathCache const&) = delete;
+        void operator=(VectorPathCache const&) = delete;
+
+        // Tessellates on a miss. The scales within half an octave share a tessellation, made for the largest of them
+        PolygonMeshHandle get(const VectorPath& path, const PathStyle& style, float scale);
+        // Marks a cached mesh as used this frame, so a handle kept in a component stays valid while it's drawn
+        void touch(PolygonMeshHandle mesh);
+        // Evicts the tessellations unused for more than the max unused frames, removing their meshes from the library
+        void beginFrame();
+        // Removes every cached mesh from the mesh library
+        void clear();
+
+        inline void setMaxUnusedFrames(unsigned long maxUnusedFrames) {m_maxUnusedFrames = maxUnusedFrames;}
+
+        inline unsigned int getHitCount() const {return m_hitCount;}
+        inline unsigned int getMissCount() const {return m_missCount;}
+        inline unsigned int getEntryCount() const {return m_entryCount;}
+
+    private:
+
+        struct Entry {
+            VectorPath m_path;
+            PathStyle m_style;
+            int m_scaleBucket;
+            PolygonMeshHandle m_mesh;
+        };
+
+        // Several entries can share the key, they're told apart by the whole path
+        std::unordered_map<uint64_t, std::vector<Entry>> m_entries;
+        // The frame each cached mesh was last looked up or drawn in
+        std::unordered_map<PolygonMeshHandle, unsigned long, HandleHash<PolygonMesh>> m_lastUsedFrames;
+        // The hashes of the paths already reported as outlined instead of filled, so each is only reported once
+        std::unordered_set<uint64_t> m_outlinedPaths;
+
+        unsigned int m_hitCount = 0;
+        unsigned int m_missCount = 0;
+        unsigned int m_entryCount = 0;
+        unsigned long m_frame = 0;
+        unsigned long m_maxUnusedFrames = 300;
+
+        PolygonMeshHandle tessellate(const VectorPath& path, const PathStyle& style, int scaleBucket);
+
+        static int getScaleBucket(float scale);
+        static uint64_t getKey(const VectorPath& path, const PathStyle& style, int scaleBucket);
+
+    };
+
+}
@@ -1,5 +1,6 @@
 #include "Renderer.h"
 
+#include <cstring>
 #include <map>
 
 namespace engine {
@@ -7,12 +8,25 @@ namespace engine {
     Renderer::RendererStorage* Renderer::m_rendererStorage = new RendererStorage;
 
     void Renderer::init() {
+        loadCameraUniformBuffer();
         loadDefaultShaders();
         loadDefaultWhiteTexture();
+        loadBatchBuffers();
     }
 
     void Renderer::beginScene(const std::shared_ptr<OrthographicCamera>& orthographicCamera) {
-        m_rendererStorage->m_viewProjectionMatrix = orthographicCamera->getViewProjectionMatrix();
+
+        // Swap in the textures decoded in the background since the last scene, before anything samples them
+        TextureLoader::getInstance().processUploads();
+
+        // Evict the least recently used textures, if over the video memory budget
+        TextureResidencyManager::getInstance().beginFrame();
+
+        // Drop the vector path tessellations that went unused for a while
+        VectorPathCache::getInstance().beginFrame();
+
+        submitViewProjectionMatrix(orthographicCamera->getViewProjectionMatrix());
+
     }
 
     void Renderer::endScene() {
@@ -28,118 +42,208 @@ namespace engine {
         }
 
         // Reset the view*projection matrix to the default
-        m_rendererStorage->m_viewProjectionMatrix = OrthographicCamera::getDefaultViewProjectionMatrix();
+        submitViewProjectionMatrix(OrthographicCamera::getDefaultViewProjectionMatrix());
 
     }
 
     void Renderer::submit(const PolygonComponent& polygonComponent, const TransformComponent& transformComponent, const MaterialComponent& materialComponent) {
 
-        // Get the vertices and indices to be added
-        auto vertices = polygonComponent.m_mesh.getVertices();
-        auto indices = polygonComponent.m_mesh.getIndices();
+        // Get the shared vertices and indices to be added, unless the mesh was removed
+        const PolygonMesh* mesh = MeshLibrary::getInstance().get(polygonComponent.m_mesh);
+        if (!mesh) {
+            return;
+        }
+
+        // Drawing a cached path tessellation counts as using it, so it isn't evicted while it's on screen
+        VectorPathCache::getInstance().touch(polygonComponent.m_mesh);
+
+        const auto& vertices = mesh->getVertices();
+        const auto& indices = mesh->getIndices();
+
+        if (sizeof(PolygonVertex) * vertices.size() + sizeof(unsigned int) * indices.size() > RendererStorage::m_maxPolygonPieceSize) {
+            submitPolygonPieces(vertices, indices, transformComponent, materialComponent);
+        } else {
+            submitPolygon(vertices, indices, transformComponent, materialComponent);
+        }
+
+    }
+
+    void Renderer::submitPolygon(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const TransformComponent& transformComponent, const MaterialComponent& materialComponent) {
 
         // Check if we need to flush before rendering the current polygon
-        if (shouldFlushPolygon(vertices, indices, materialComponent.m_texture)) {
+        if (shouldFlushPolygon(materialComponent.m_texture, vertices, indices)) {
             flushPolygons();
         }
 
+        // Or only start a new draw in the same batch, unless the batch is full of draws already
+        if (shouldClosePolygonDraw(vertices, indices)) {
+            if (m_rendererStorage->m_polygonDraws.size() + 1 >= m_rendererStorage->m_maxPolygonDraws) {
+                flushPolygons();
+            } else {
+                closePolygonDraw();
+            }
+        }
+
         // If no texture is specified, we use texture number 1, which is the default white texture
         int textureIndex = 0.0f;
         if (materialComponent.m_texture) {
 
             // Find the texture in the list of existing textures
-            auto iterator = std::find(m_rendererStorage->m_polygonTextures.begin(), m_rendererStorage->m_polygonTextures.end(), materialComponent.m_texture);
+            auto iterator = std::find(m_rendererStorage->m_polygonTextures.begin(), m_rendererStorage->m_polygonTextures.end(), materialComponent.m_texture->getHandle());
 
             // If it isn't there, we need to add it
             if (iterator == m_rendererStorage->m_polygonTextures.end()) {
                 textureIndex = m_rendererStorage->m_polygonTextures.size();
-                m_rendererStorage->m_polygonTextures.push_back(materialComponent.m_texture);
+                m_rendererStorage->m_polygonTextures.push_back(materialComponent.m_texture->getHandle());
             } else { // Otherwise, retrieve the index of the existing one
                 textureIndex = (int) std::distance(m_rendererStorage->m_polygonTextures.begin(), iterator);
             }
 
         }
 
-        // Transform the vertices, according to the polygon's transform and material components
-        for (auto& vertex : vertices) {
-            vertex.m_position = transformComponent.getTransformationMatrix() * vertex.m_position;
+        // Transform the indices, offset them by the vertices already in the draw (the draw's base vertex does the rest), into the batch
+        unsigned int indexOffset = m_rendererStorage->m_polygonVertices.size() - m_rendererStorage->m_polygonDrawVertexStart;
+        for (auto index : indices) {
+            m_rendererStorage->m_polygonIndices.push_back(index + indexOffset);
+        }
+
+        // Transform the vertices, according to the polygon's transform and material components (mapping the texture coordinates into the material's region), into the batch
+        glm::mat4 transformationMatrix = transformComponent.getTransformationMatrix();
+        glm::vec2 textureCoordinatesScale = materialComponent.m_textureCoordinatesMax - materialComponent.m_textureCoordinatesMin;
+        for (const auto& meshVertex : vertices) {
+            PolygonVertex& vertex = m_rendererStorage->m_polygonVertices.emplace_back(meshVertex);
+            vertex.m_position = transformationMatrix * vertex.m_position;
+            vertex.m_textureCoordinates = materialComponent.m_textureCoordinatesMin + vertex.m_textureCoordinates * textureCoordinatesScale;
             vertex.m_textureIndex = textureIndex;
             vertex.m_color = materialComponent.m_color;
         }
 
-        // Transform the indices, offset them by the current list of vertices in the batch
-        for (auto& index : indices) {
-            index += m_rendererStorage->m_polygonVertices.size();
+    }
+
+    void Renderer::submitPolygonPieces(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const TransformComponent& transformComponent, const MaterialComponent& materialComponent) {
+
+        auto& pieceVertices = m_rendererStorage->m_polygonPieceVertices;
+        auto& pieceIndices = m_rendererStorage->m_polygonPieceIndices;
+        auto& pieceSources = m_rendererStorage->m_polygonPieceSources;
+        auto& remap = m_rendererStorage->m_polygonPieceRemap;
+        remap.assign(vertices.size(), -1);
+        pieceVertices.clear();
+        pieceIndices.clear();
+        pieceSources.clear();
+
+        // Triangle by triangle, copying in the vertices each piece uses
+        for (unsigned int first = 0; first + 2 < indices.size(); first += 3) {
+
+            // Submit the piece once the next triangle might not fit in it
+            unsigned int pieceSize = sizeof(PolygonVertex) * (pieceVertices.size() + 3) + sizeof(unsigned int) * (pieceIndices.size() + 3);
+            if (pieceSize > RendererStorage::m_maxPolygonPieceSize) {
+
+                submitPolygon(pieceVertices, pieceIndices, transformComponent, materialComponent);
+
+                for (auto source : pieceSources) {
+                    remap[source] = -1;
+                }
+                pieceSources.clear();
+                pieceVertices.clear();
+                pieceIndices.clear();
+
+            }
+
+            for (unsigned int corner = 0; corner < 3; corner++) {
+
+                unsigned int index = indices[first + corner];
+                if (remap[index] < 0) {
+                    remap[index] = (int) pieceVertices.size();
+                    pieceVertices.push_back(vertices[index]);
+                    pieceSources.push_back(index);
+                }
+
+                pieceIndices.push_back(remap[index]);
+
+            }
+
         }
 
-        // Store the vertices and indices in the batch
-        m_rendererStorage->m_polygonVertices.insert(m_rendererStorage->m_polygonVertices.end(), vertices.begin(), vertices.end());
-        m_rendererStorage->m_polygonIndices.insert(m_rendererStorage->m_polygonIndices.end(), indices.begin(), indices.end());
+        if (!pieceIndices.empty()) {
+            submitPolygon(pieceVertices, pieceIndices, transformComponent, materialComponent);
+        }
 
     }
 
     void Renderer::submit(const CircleComponent& circleComponent, const TransformComponent& transformComponent, const MaterialComponent& materialComponent) {
 
-        // Get the vertices and indices to be added
-        auto vertices = circleComponent.m_mesh.getVertices();
-        auto indices = circleComponent.m_mesh.getIndices();
+        // Get the shared vertices and indices to be added
+        const auto& vertices = m_rendererStorage->m_circleMesh.getVertices();
+        const auto& indices = m_rendererStorage->m_circleMesh.getIndices();
 
         // Check if we need to flush before rendering the current circle
-        if (shouldFlushCircles(vertices, materialComponent.m_texture)) {
+        if (shouldFlushCircles(materialComponent.m_texture, vertices, indices)) {
             flushCircles();
         }
 
+        // Or only start a new draw in the same batch, unless the batch is full of draws already
+        if (shouldCloseCircleDraw(vertices)) {
+            if (m_rendererStorage->m_circleDraws.size() + 1 >= m_rendererStorage->m_maxCircleDraws) {
+                flushCircles();
+            } else {
+                closeCircleDraw();
+            }
+        }
+
         // If no texture is specified, we use texture number 1, which is the default white texture
         int textureIndex = 0.0f;
         if (materialComponent.m_texture) {
 
             // Find the texture in the list of existing textures
-            auto iterator = std::find(m_rendererStorage->m_circleTextures.begin(), m_rendererStorage->m_circleTextures.end(), materialComponent.m_texture);
+            auto iterator = std::find(m_rendererStorage->m_circleTextures.begin(), m_rendererStorage->m_circleTextures.end(), materialComponent.m_texture->getHandle());
 
             // If it isn't there, we need to add it
             if (iterator == m_rendererStorage->m_circleTextures.end()) {
                 textureIndex = m_rendererStorage->m_circleTextures.size();
-                m_rendererStorage->m_circleTextures.push_back(materialComponent.m_texture);
+                m_rendererStorage->m_circleTextures.push_back(materialComponent.m_texture->getHandle());
             } else { // Otherwise, retrieve the index of the existing one
                 textureIndex = (int) std::distance(m_rendererStorage->m_circleTextures.begin(), iterator);
             }
 
         }
 
-        // Transform the vertices, according to the circle's transform, material, and circle components
-        for (auto& vertex : vertices) {
-            vertex.m_position = transformComponent.getTransformationMatrix() * vertex.m_position;
+        // Hard-edged circles can use the cheaper shader variant, unless another circle in the batch needs fading
+        if (circleComponent.m_fade > 0.0f) {
+            m_rendererStorage->m_circleBatchFaded = true;
+        }
+
+        // Transform the indices, offset them by the vertices already in the draw (the draw's base vertex does the rest), into the batch
+        unsigned int indexOffset = m_rendererStorage->m_circleVertices.size() - m_rendererStorage->m_circleDrawVertexStart;
+        for (auto index : indices) {
+            m_rendererStorage->m_circleIndices.push_back(index + indexOffset);
+        }
+
+        // Transform the vertices, according to the circle's transform, material (mapping the texture coordinates into its region), and circle components, into the batch
+        glm::mat4 transformationMatrix = transformComponent.getTransformationMatrix();
+        glm::vec2 textureCoordinatesScale = materialComponent.m_textureCoordinatesMax - materialComponent.m_textureCoordinatesMin;
+        for (const auto& meshVertex : vertices) {
+            CircleVertex& vertex = m_rendererStorage->m_circleVertices.emplace_back(meshVertex);
+            vertex.m_position = transformationMatrix * vertex.m_position;
             vertex.m_thickness = circleComponent.m_thickness;
             vertex.m_fade = circleComponent.m_fade;
+            vertex.m_textureCoordinates = materialComponent.m_textureCoordinatesMin + vertex.m_textureCoordinates * textureCoordinatesScale;
             vertex.m_textureIndex = textureIndex;
             vertex.m_color = materialComponent.m_color;
         }
 
-        // Transform the indices, offset them by the current list of vertices in the batch
-        for (auto& index : indices) {
-            index += m_rendererStorage->m_circleVertices.size();
-        }
-
-        // Store the vertices and indices in the batch
-        m_rendererStorage->m_circleVertices.insert(m_rendererStorage->m_circleVertices.end(), vertices.begin(), vertices.end());
-        m_rendererStorage->m_circleIndices.insert(m_rendererStorage->m_circleIndices.end(), indices.begin(), indices.end());
-
     }
 
-    bool Renderer::shouldFlushPolygon(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const std::shared_ptr<Texture>& texture) {
+    bool Renderer::shouldFlushPolygon(const std::shared_ptr<Texture>& texture, const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices) {
 
-        // If rendering the current polygon would pass over the limit of vertices, flush
-        if (m_rendererStorage->m_polygonVertices.size() + vertices.size() > m_rendererStorage->m_maxPolygonVertices) {
-            return true;
-        }
-
-        // If rendering the current polygon would pass over the limit of indices, flush
-        if (m_rendererStorage->m_polygonIndices.size() + indices.size() > m_rendererStorage->m_maxPolygonIndices) {
+        // If rendering the current polygon would pass over the size of the streaming buffer, flush
+        unsigned int vertexCount = m_rendererStorage->m_polygonVertices.size() + vertices.size();
+        unsigned int indexCount = m_rendererStorage->m_polygonIndices.size() + indices.size();
+        if (sizeof(PolygonVertex) * vertexCount + sizeof(unsigned int) * indexCount > RendererStorage::m_streamingBufferSize) {
             return true;
         }
 
         // If we're adding a texture, and it would pass over the limit of textures, flush
-        if (texture && std::find(m_rendererStorage->m_polygonTextures.begin(), m_rendererStorage->m_polygonTextures.end(), texture) == m_rendererStorage->m_polygonTextures.end()) {
+        if (texture && std::find(m_rendererStorage->m_polygonTextures.begin(), m_rendererStorage->m_polygonTextures.end(), texture->getHandle()) == m_rendererStorage->m_polygonTextures.end()) {
 
             if (m_rendererStorage->m_polygonTextures.size() + 1 > m_rendererStorage->m_maxPolygonTextures) {
                 return true;
@@ -151,17 +255,17 @@ namespace engine {
 
     }
 
-    bool Renderer::shouldFlushCircles(const std::vector<CircleVertex>& vertices, const std::shared_ptr<Texture>& texture) {
+    bool Renderer::shouldFlushCircles(const std::shared_ptr<Texture>& texture, const std::vector<CircleVertex>& vertices, const std::vector<unsigned int>& indices) {
 
-        // If rendering the current circle would pass over the limit of vertices, flush
-        if (m_rendererStorage->m_circleVertices.size() + vertices.size() > m_rendererStorage->m_maxCircleVertices) {
+        // If rendering the current circle would pass over the size of the streaming buffer, flush
+        unsigned int vertexCount = m_rendererStorage->m_circleVertices.size() + vertices.size();
+        unsigned int indexCount = m_rendererStorage->m_circleIndices.size() + indices.size();
+        if (sizeof(CircleVertex) * vertexCount + sizeof(unsigned int) * indexCount > RendererStorage::m_streamingBufferSize) {
             return true;
         }
 
-        // No need to check for indices limit, because a circle always has 4 vertices
-
         // If we're adding a texture, and it would pass over the limit of textures, flush
-        if (texture && std::find(m_rendererStorage->m_circleTextures.begin(), m_rendererStorage->m_circleTextures.end(), texture) == m_rendererStorage->m_circleTextures.end()) {
+        if (texture && std::find(m_rendererStorage->m_circleTextures.begin(), m_rendererStorage->m_circleTextures.end(), texture->getHandle()) == m_rendererStorage->m_circleTextures.end()) {
 
             if (m_rendererStorage->m_circleTextures.size() + 1 > m_rendererStorage->m_maxCircleTextures) {
                 return true;
@@ -173,82 +277,157 @@ namespace engine {
 
     }
 
-    void Renderer::flushPolygons() {
+    bool Renderer::shouldClosePolygonDraw(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices) {
+
+        // If rendering the current polygon would pass over the limit of vertices of the draw, close it
+        if (m_rendererStorage->m_polygonVertices.size() - m_rendererStorage->m_polygonDrawVertexStart + vertices.size() > m_rendererStorage->m_maxPolygonVertices) {
+            return true;
+        }
+
+        // If rendering the current polygon would pass over the limit of indices of the draw, close it
+        if (m_rendererStorage->m_polygonIndices.size() - m_rendererStorage->m_polygonDrawIndexStart + indices.size() > m_rendererStorage->m_maxPolygonIndices) {
+            return true;
+        }
+
+        return false;
+
+    }
+
+    bool Renderer::shouldCloseCircleDraw(const std::vector<CircleVertex>& vertices) {
+
+        // If rendering the current circle would pass over the limit of vertices of the draw, close it
+        // No need to check for indices limit, because a circle always has 4 vertices
+        return m_rendererStorage->m_circleVertices.size() - m_rendererStorage->m_circleDrawVertexStart + vertices.size() > m_rendererStorage->m_maxCircleVertices;
+
+    }
+
+    void Renderer::closePolygonDraw() {
+
+        unsigned int indexCount = m_rendererStorage->m_polygonIndices.size() - m_rendererStorage->m_polygonDrawIndexStart;
+        if (indexCount > 0) {
+            m_rendererStorage->m_polygonDraws.push_back({indexCount, 1, m_rendererStorage->m_polygonDrawIndexStart, (int) m_rendererStorage->m_polygonDrawVertexStart, 0});
+        }
+
+        // The next draw starts after this one, in the same buffers
+        m_rendererStorage->m_polygonDrawVertexStart = m_rendererStorage->m_polygonVertices.size();
+        m_rendererStorage->m_polygonDrawIndexStart = m_rendererStorage->m_polygonIndices.size();
+
+    }
+
+    void Renderer::closeCircleDraw() {
+
+        unsigned int indexCount = m_rendererStorage->m_circleIndices.size() - m_rendererStorage->m_circleDrawIndexStart;
+        if (indexCount > 0) {
+            m_rendererStorage->m_circleDraws.push_back({indexCount, 1, m_rendererStorage->m_circleDrawIndexStart, (int) m_rendererStorage->m_circleDrawVertexStart, 0});
+        }
+
+        // The next draw starts after this one, in the same buffers
+        m_rendererStorage->m_circleDrawVertexStart = m_rendererStorage->m_circleVertices.size();
+        m_rendererStorage->m_circleDrawIndexStart = m_rendererStorage->m_circleIndices.size();
 
-        // Create a layout, based on the structure of PolygonVertex
-        static engine::BufferLayout layout = {
-                {"a_position", 4, engine::VertexBufferLayoutElementType::Float},
-                {"a_textureCoordinates", 2, engine::VertexBufferLayoutElementType::Float},
-                {"a_textureIndex", 1, engine::VertexBufferLayoutElementType::Int},
-                {"a_color", 4, engine::VertexBufferLayoutElementType::Float},
-        };
+    }
 
-        // Create the vertex and index buffers
-        std::shared_ptr<VertexBuffer> vertexBuffer = std::make_shared<VertexBuffer>(layout, (const void*) m_rendererStorage->m_polygonVertices.data(), sizeof(PolygonVertex) * m_rendererStorage->m_polygonVertices.size());
-        std::shared_ptr<IndexBuffer> indexBuffer = std::make_shared<IndexBuffer>((unsigned int*) m_rendererStorage->m_polygonIndices.data(), m_rendererStorage->m_polygonIndices.size());
+    void Renderer::flushPolygons() {
 
-        // Bind them together into a vertex array
-        std::shared_ptr<VertexArray> vertexArray = std::make_shared<VertexArray>();
-        vertexArray->addBuffer(vertexBuffer, indexBuffer);
+        // Close the last draw, so every draw of the batch is queued
+        closePolygonDraw();
+
+        // Stream the vertices and indices, in a single allocation (another one could orphan the buffer in between)
+        unsigned int verticesSize = sizeof(PolygonVertex) * m_rendererStorage->m_polygonVertices.size();
+        unsigned int indicesSize = sizeof(unsigned int) * m_rendererStorage->m_polygonIndices.size();
+        StreamingAllocation allocation = m_rendererStorage->m_streamingBuffer->allocate(verticesSize + indicesSize, sizeof(PolygonVertex));
+        std::memcpy(allocation.m_data, m_rendererStorage->m_polygonVertices.data(), verticesSize);
+        std::memcpy((unsigned char*) allocation.m_data + verticesSize, m_rendererStorage->m_polygonIndices.data(), indicesSize);
+        m_rendererStorage->m_streamingBuffer->commit();
+
+        // Point the draws at where the batch landed (the allocation is aligned to the vertex size, for this)
+        for (auto& draw : m_rendererStorage->m_polygonDraws) {
+            draw.m_baseVertex += allocation.m_offset / sizeof(PolygonVertex);
+            draw.m_firstIndex += (allocation.m_offset + verticesSize) / sizeof(unsigned int);
+        }
 
         // Bind all the textures
         for (unsigned int i = 0; i < m_rendererStorage->m_polygonTextures.size(); i++) {
-            m_rendererStorage->m_polygonTextures[i]->bind(i);
+
+            // The texture may have been destroyed since it was submitted
+            Texture* texture = Texture::get(m_rendererStorage->m_polygonTextures[i]);
+            if (!texture) {
+                texture = m_rendererStorage->m_whiteTexture.get();
+            }
+
+            TextureResidencyManager::getInstance().touch(texture);
+            texture->bind(i);
+
         }
 
-        // Submit the vertex array, to be rendered by the polygon shader
-        submitTriangles(m_rendererStorage->m_shaderLibrary.get("polygon-shader"), vertexArray);
+        // Submit the draws, to be rendered by the cheapest polygon shader variant for this batch (only the white texture means untextured)
+        bool textured = m_rendererStorage->m_polygonTextures.size() > 1;
+        submitDraws(getPolygonShader(textured), m_rendererStorage->m_polygonVertexArray, m_rendererStorage->m_polygonDraws);
 
-        // Clear the batch vectors (vertices, indices, and textures), and add the white texture back
+        // Clear the batch vectors (vertices, indices, draws, and textures), and add the white texture back
         m_rendererStorage->m_polygonVertices.clear();
         m_rendererStorage->m_polygonIndices.clear();
+        m_rendererStorage->m_polygonDraws.clear();
+        m_rendererStorage->m_polygonDrawVertexStart = 0;
+        m_rendererStorage->m_polygonDrawIndexStart = 0;
         m_rendererStorage->m_polygonTextures.clear();
-        m_rendererStorage->m_polygonTextures.push_back(m_rendererStorage->m_whiteTexture);
+        m_rendererStorage->m_polygonTextures.push_back(m_rendererStorage->m_whiteTexture->getHandle());
 
     }
 
     void Renderer::flushCircles() {
 
-        // Create a layout, based on the structure of CircleVertex
-        static engine::BufferLayout layout = {
-            {"a_position", 4, engine::VertexBufferLayoutElementType::Float},
-            {"a_localCoordinates", 2, engine::VertexBufferLayoutElementType::Float},
-            {"a_thickness", 1, engine::VertexBufferLayoutElementType::Float},
-            {"a_fade", 1, engine::VertexBufferLayoutElementType::Float},
-            {"a_textureCoordinates", 2, engine::VertexBufferLayoutElementType::Float},
-            {"a_textureIndex", 1, engine::VertexBufferLayoutElementType::Int},
-            {"a_color", 4, engine::VertexBufferLayoutElementType::Float},
-        };
-
-        // Create the vertex and index buffers
-        std::shared_ptr<VertexBuffer> vertexBuffer = std::make_shared<VertexBuffer>(layout, (const void*) m_rendererStorage->m_circleVertices.data(), sizeof(CircleVertex) * m_rendererStorage->m_circleVertices.size());
-        std::shared_ptr<IndexBuffer> indexBuffer = std::make_shared<IndexBuffer>(m_rendererStorage->m_circleIndices.data(), m_rendererStorage->m_circleIndices.size());
-
-        // Bind them together into a vertex array
-        std::shared_ptr<VertexArray> vertexArray = std::make_shared<VertexArray>();
-        vertexArray->addBuffer(vertexBuffer, indexBuffer);
+        // Close the last draw, so every draw of the batch is queued
+        closeCircleDraw();
+
+        // Stream the vertices and indices, in a single allocation (another one could orphan the buffer in between)
+        unsigned int verticesSize = sizeof(CircleVertex) * m_rendererStorage->m_circleVertices.size();
+        unsigned int indicesSize = sizeof(unsigned int) * m_rendererStorage->m_circleIndices.size();
+        StreamingAllocation allocation = m_rendererStorage->m_streamingBuffer->allocate(verticesSize + indicesSize, sizeof(CircleVertex));
+        std::memcpy(allocation.m_data, m_rendererStorage->m_circleVertices.data(), verticesSize);
+        std::memcpy((unsigned char*) allocation.m_data + verticesSize, m_rendererStorage->m_circleIndices.data(), indicesSize);
+        m_rendererStorage->m_streamingBuffer->commit();
+
+        // Point the draws at where the batch landed (the allocation is aligned to the vertex size, for this)
+        for (auto& draw : m_rendererStorage->m_circleDraws) {
+            draw.m_baseVertex += allocation.m_offset / sizeof(CircleVertex);
+            draw.m_firstIndex += (allocation.m_offset + verticesSize) / sizeof(unsigned int);
+        }
 
         // Bind all the textures
         for (unsigned int i = 0; i < m_rendererStorage->m_circleTextures.size(); i++) {
-            m_rendererStorage->m_circleTextures[i]->bind(i);
+
+            // The texture may have been destroyed since it was submitted
+            Texture* texture = Texture::get(m_rendererStorage->m_circleTextures[i]);
+            if (!texture) {
+                texture = m_rendererStorage->m_whiteTexture.get();
+            }
+
+            TextureResidencyManager::getInstance().touch(texture);
+            texture->bind(i);
+
         }
 
-        // Submit the vertex array, to be rendered by the circle shader
-        submitCircles(m_rendererStorage->m_shaderLibrary.get("circle-shader"), vertexArray);
+        // Submit the draws, to be rendered by the cheapest circle shader variant for this batch (only the white texture means untextured)
+        bool textured = m_rendererStorage->m_circleTextures.size() > 1;
+        submitDraws(getCircleShader(textured, m_rendererStorage->m_circleBatchFaded), m_rendererStorage->m_circleVertexArray, m_rendererStorage->m_circleDraws);
 
-        // Clear the batch vectors (vertices, indices, and textures), and add the white texture back
+        // Clear the batch vectors (vertices, indices, draws, and textures), and add the white texture back
         m_rendererStorage->m_circleVertices.clear();
         m_rendererStorage->m_circleIndices.clear();
+        m_rendererStorage->m_circleDraws.clear();
+        m_rendererStorage->m_circleDrawVertexStart = 0;
+        m_rendererStorage->m_circleDrawIndexStart = 0;
         m_rendererStorage->m_circleTextures.clear();
-        m_rendererStorage->m_circleTextures.push_back(m_rendererStorage->m_whiteTexture);
+        m_rendererStorage->m_circleTextures.push_back(m_rendererStorage->m_whiteTexture->getHandle());
+        m_rendererStorage->m_circleBatchFaded = false;
 
     }
 
     void Renderer::submitTriangles(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) {
 
-        // Bind the shader and submit the view*projection matrix as a uniform
+        // Bind the shader (the view*projection matrix is already in the camera uniform buffer)
         shader->bind();
-        shader->setUniformMat4f("u_viewProjection", m_rendererStorage->m_viewProjectionMatrix);
 
         // Bind the vertex array and the index buffer
         vertexArray->bind();
@@ -261,9 +440,8 @@ namespace engine {
 
     void Renderer::submitCircles(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) {
 
-        // Bind the shader and submit the view*projection matrix as a uniform
+        // Bind the shader (the view*projection matrix is already in the camera uniform buffer)
         shader->bind();
-        shader->setUniformMat4f("u_viewProjection", m_rendererStorage->m_viewProjectionMatrix);
 
         // Bind the vertex array and the index buffer
         vertexArray->bind();
@@ -274,32 +452,143 @@ namespace engine {
 
     }
 
+    void Renderer::submitGeometry(const std::shared_ptr<Shader>& shader, GeometryPool& geometryPool, const std::vector<GeometryHandle>& meshes) {
+
+        // One draw per mesh, each at its own place in the pool's buffers, skipping the ones already removed
+        auto& draws = m_rendererStorage->m_geometryDraws;
+        draws.clear();
+
+        DrawIndexedCommand draw;
+        for (auto mesh : meshes) {
+            if (geometryPool.getDrawCommand(mesh, draw)) {
+                draws.push_back(draw);
+            }
+        }
+
+        if (draws.empty()) {
+            return;
+        }
+
+        // Bind the shader (the view*projection matrix is already in the camera uniform buffer)
+        shader->bind();
+
+        // Bind the vertex array shared by the pool's layout, pointed at the pool's buffers
+        geometryPool.bind();
+
+        // Render every mesh as triangles, in a single call when the driver supports it
+        RenderCommand::drawIndexedTrianglesIndirect(draws.data(), draws.size());
+
+    }
+
+    void Renderer::submitDraws(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::vector<DrawIndexedCommand>& draws) {
+
+        // Bind the shader (the view*projection matrix is already in the camera uniform buffer)
+        shader->bind();
+
+        // The vertex array is shared with anything else using the same layout, so point it at the streaming buffer
+        unsigned int bufferId = m_rendererStorage->m_streamingBuffer->getRendererId();
+        vertexArray->setBuffers(bufferId, bufferId);
+        vertexArray->bind();
+
+        // Render every draw of the batch as triangles, in a single call when the driver supports it
+        RenderCommand::drawIndexedTrianglesIndirect(draws.data(), draws.size());
+
+    }
+
+    void Renderer::bindCameraUniformBlock(const std::shared_ptr<Shader>& shader) {
+        shader->bindUniformBlock("Camera", RendererStorage::m_cameraUniformBlockBinding);
+    }
+
+    void Renderer::submitViewProjectionMatrix(const glm::mat4& viewProjectionMatrix) {
+
+        // Written once per scene, and read by every shader bound to the camera block
+        CameraUniformBlock cameraUniformBlock = {viewProjectionMatrix};
+        m_rendererStorage->m_cameraUniformBuffer->setData(&cameraUniformBlock, sizeof(CameraUniformBlock));
+
+    }
+
+    void Renderer::loadCameraUniformBuffer() {
+
+        // Create the uniform buffer shared by all the pipelines, and start with the default view*projection matrix
+        m_rendererStorage->m_cameraUniformBuffer = std::make_shared<UniformBuffer>(sizeof(CameraUniformBlock), RendererStorage::m_cameraUniformBlockBinding);
+        submitViewProjectionMatrix(OrthographicCamera::getDefaultViewProjectionMatrix());
+
+    }
+
     void Renderer::loadDefaultShaders() {
 
-        // Create the polygon shader
-        std::map<engine::ShaderType, std::string> polygonShaderSource {
-            {engine::ShaderType::Vertex, ASSETS_PATH"/shaders/2d/polygon-vertex-position-2d.glsl"},
-            {engine::ShaderType::Fragment, ASSETS_PATH"/shaders/2d/polygon-color-texture-2d.glsl"}
-        };
-        auto polygonShader = m_rendererStorage->m_shaderLibrary.load("polygon-shader", polygonShaderSource);
+        // Reuse the linked programs from previous runs, when the driver allows it
+        m_rendererStorage->m_shaderLibrary.enableBinaryCache(SHADER_CACHE_PATH);
+
+        // Load the base polygon and circle shaders in one batch, so they compile in parallel
+        m_rendererStorage->m_shaderLibrary.load({
+            {"polygon-shader", {
+                {engine::ShaderType::Vertex, ASSETS_PATH"/shaders/2d/polygon-vertex-position-2d.glsl"},
+                {engine::ShaderType::Fragment, ASSETS_PATH"/shaders/2d/polygon-color-texture-2d.glsl"}
+            }},
+            {"circle-shader", {
+                {engine::ShaderType::Vertex, ASSETS_PATH"/shaders/2d/circle-vertex-position-2d.glsl"},
+                {engine::ShaderType::Fragment, ASSETS_PATH"/shaders/2d/circle-color-texture-2d.glsl"}
+            }}
+        });
+
+        // Set up the base variants, the rest get compiled the first time a batch needs them
+        getPolygonShader(false);
+        getCircleShader(false, false);
+
+    }
+
+    const std::shared_ptr<Shader>& Renderer::getPolygonShader(bool textured) {
+
+        auto& shader = m_rendererStorage->m_polygonShaders[textured ? 1 : 0];
+
+        if (!shader) {
+
+            std::vector<std::string> defines;
+            if (textured) {
+                defines.emplace_back("TEXTURED");
+            }
+
+            shader = m_rendererStorage->m_shaderLibrary.getVariant("polygon-shader", defines);
+            setupShader(shader, RendererStorage::m_maxPolygonTextures);
 
-        // Set all the texture slots as uniforms
-        for (int i = 0; i < m_rendererStorage->m_maxPolygonTextures; i++) {
-            auto textureName = std::string("texture") + std::to_string(i);
-            polygonShader->setUniform1i(textureName, i);
         }
 
-        // Create the circle shader
-        std::map<engine::ShaderType, std::string> circleShaderSource {
-            {engine::ShaderType::Vertex, ASSETS_PATH"/shaders/2d/circle-vertex-position-2d.glsl"},
-            {engine::ShaderType::Fragment, ASSETS_PATH"/shaders/2d/circle-color-texture-2d.glsl"}
-        };
-        auto circleShader = m_rendererStorage->m_shaderLibrary.load("circle-shader", circleShaderSource);
+        return shader;
+
+    }
+
+    const std::shared_ptr<Shader>& Renderer::getCircleShader(bool textured, bool faded) {
+
+        auto& shader = m_rendererStorage->m_circleShaders[(textured ? 1 : 0) + (faded ? 2 : 0)];
+
+        if (!shader) {
 
-        // Set all the texture slots as uniforms
-        for (int i = 0; i < m_rendererStorage->m_maxCircleTextures; i++) {
+            std::vector<std::string> defines;
+            if (textured) {
+                defines.emplace_back("TEXTURED");
+            }
+            if (faded) {
+                defines.emplace_back("FADE");
+            }
+
+            shader = m_rendererStorage->m_shaderLibrary.getVariant("circle-shader", defines);
+            setupShader(shader, RendererStorage::m_maxCircleTextures);
+
+        }
+
+        return shader;
+
+    }
+
+    void Renderer::setupShader(const std::shared_ptr<Shader>& shader, unsigned int textureCount) {
+
+        bindCameraUniformBlock(shader);
+
+        // Set all the texture slots as uniforms (untextured variants simply don't have them)
+        for (unsigned int i = 0; i < textureCount; i++) {
             auto textureName = std::string("texture") + std::to_string(i);
-            circleShader->setUniform1i(textureName, i);
+            shader->setUniform1i(textureName, i);
         }
 
     }
@@ -311,9 +600,26 @@ namespace engine {
         std::shared_ptr<engine::Texture> whiteTexture = std::make_shared<engine::Texture>(1, 1, &whiteTextureData);
         m_rendererStorage->m_whiteTexture = whiteTexture;
 
+        // Textures that are still loading render as white
+        Texture::setPlaceholder(whiteTexture);
+
         // Add it to the polygon and circle texture vectors
-        m_rendererStorage->m_polygonTextures.push_back(whiteTexture);
-        m_rendererStorage->m_circleTextures.push_back(whiteTexture);
+        m_rendererStorage->m_polygonTextures.push_back(whiteTexture->getHandle());
+        m_rendererStorage->m_circleTextures.push_back(whiteTexture->getHandle());
+
+    }
+
+    void Renderer::loadBatchBuffers() {
+
+        // One buffer streams every batch, vertices and indices alike
+        m_rendererStorage->m_streamingBuffer = std::make_shared<StreamingBuffer>(RendererStorage::m_streamingBufferSize);
+
+        // The layouts come from the vertex structs, and their vertex arrays are set up once, and shared
+        BufferLayout polygonLayout = BufferLayout::of<PolygonVertex>();
+        m_rendererStorage->m_polygonVertexArray = VertexArray::get(polygonLayout);
+
+        BufferLayout circleLayout = BufferLayout::of<CircleVertex>();
+        m_rendererStorage->m_circleVertexArray = VertexArray::get(circleLayout);
 
     }
 
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "../../graphics/buffer/VertexArray.h"
+#include "../../graphics/buffer/StreamingBuffer.h"
+#include "../../graphics/buffer/GeometryPool.h"
+#include "../../graphics/buffer/UniformBuffer.h"
 #include "../../graphics/texture/Texture.h"
+#include "../../graphics/texture/TextureLoader.h"
+#include "../../graphics/texture/TextureResidencyManager.h"
 
 #include "../../graphics/shader/Shader.h"
 #include "../../graphics/shader/ShaderLibrary.h"
 
 #include "../entity/GraphicsComponents.h"
+#include "../mesh/CircleMesh.h"
+#include "../mesh/VectorPathCache.h"
 
 #include "../camera/OrthographicCamera.h"
 
@@ -40,16 +47,48 @@ namespace engine {
         // Non-batched, direct draw calls
         static void submitTriangles(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray);
         static void submitCircles(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray);
+        static void submitGeometry(const std::shared_ptr<Shader>& shader, GeometryPool& geometryPool, const std::vector<GeometryHandle>& meshes);
+
+        // Point a shader's "Camera" uniform block to the shared camera uniform buffer
+        static void bindCameraUniformBlock(const std::shared_ptr<Shader>& shader);
 
     private:
 
         // Init loaders
+        static void loadCameraUniformBuffer();
         static void loadDefaultShaders();
         static void loadDefaultWhiteTexture();
+        static void loadBatchBuffers();
+
+        // Add a polygon's vertices and indices to the batch. A mesh too big to stream in one piece is split into pieces
+        // of whole triangles, each batched on its own
+        static void submitPolygon(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const TransformComponent& transformComponent, const MaterialComponent& materialComponent);
+        static void submitPolygonPieces(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const TransformComponent& transformComponent, const MaterialComponent& materialComponent);
 
         // Internal batch checks
-        static bool shouldFlushPolygon(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices, const std::shared_ptr<Texture>& texture);
-        static bool shouldFlushCircles(const std::vector<CircleVertex>& vertices, const std::shared_ptr<Texture>& texture);
+        static bool shouldFlushPolygon(const std::shared_ptr<Texture>& texture, const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices);
+        static bool shouldFlushCircles(const std::shared_ptr<Texture>& texture, const std::vector<CircleVertex>& vertices, const std::vector<unsigned int>& indices);
+        static bool shouldClosePolygonDraw(const std::vector<PolygonVertex>& vertices, const std::vector<unsigned int>& indices);
+        static bool shouldCloseCircleDraw(const std::vector<CircleVertex>& vertices);
+
+        // Hitting a vertex or index limit doesn't change the pipeline, so it only closes a draw, and the whole batch
+        // of draws is rendered with one multi-draw at the flush
+        static void closePolygonDraw();
+        static void closeCircleDraw();
+        static void submitDraws(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::vector<DrawIndexedCommand>& draws);
+
+        // Shader variants, cached after their first use
+        static const std::shared_ptr<Shader>& getPolygonShader(bool textured);
+        static const std::shared_ptr<Shader>& getCircleShader(bool textured, bool faded);
+        static void setupShader(const std::shared_ptr<Shader>& shader, unsigned int textureCount);
+
+        // Write the view*projection matrix into the camera uniform buffer
+        static void submitViewProjectionMatrix(const glm::mat4& viewProjectionMatrix);
+
+        // Mirrors the std140 layout of the "Camera" uniform block in the shaders
+        struct CameraUniformBlock {
+            glm::mat4 m_viewProjection;
+        };
 
         struct RendererStorage {
 
@@ -61,7 +100,12 @@ namespace engine {
             std::vector<unsigned int> m_polygonIndices = {};
 
             static const unsigned int m_maxPolygonTextures = 10;
-            std::vector<std::shared_ptr<Texture> > m_polygonTextures = {};
+            std::vector<TextureHandle> m_polygonTextures = {}; // Handles, so batching doesn't touch reference counts
+
+            static const unsigned int m_maxPolygonDraws = 64; // Per multi-draw
+            std::vector<DrawIndexedCommand> m_polygonDraws = {};
+            unsigned int m_polygonDrawVertexStart = 0; // Where the open draw starts, in the batch
+            unsigned int m_polygonDrawIndexStart = 0;
 
             // Circles
             static const unsigned int m_maxCircleVertices = 100;
@@ -70,14 +114,35 @@ namespace engine {
             std::vector<unsigned int> m_circleIndices = {};
 
             static const unsigned int m_maxCircleTextures = 10;
-            std::vector<std::shared_ptr<Texture> > m_circleTextures = {};
+            std::vector<TextureHandle> m_circleTextures = {}; // Handles, so batching doesn't touch reference counts
+
+            static const unsigned int m_maxCircleDraws = 64; // Per multi-draw
+            std::vector<DrawIndexedCommand> m_circleDraws = {};
+            CircleMesh m_circleMesh; // The unit quad every circle is drawn on
+            unsigned int m_circleDrawVertexStart = 0; // Where the open draw starts, in the batch
+            unsigned int m_circleDrawIndexStart = 0;
+
+            bool m_circleBatchFaded = false;
 
             // Shared
-            glm::mat4 m_viewProjectionMatrix;
+            static const unsigned int m_streamingBufferSize = 4 * 1024 * 1024; // A batch is flushed before it outgrows it
+            static const unsigned int m_maxPolygonPieceSize = m_streamingBufferSize / 4; // Bigger meshes are split into pieces of this size, at most
+            std::shared_ptr<StreamingBuffer> m_streamingBuffer = nullptr; // Every batch's vertices and indices
+            std::vector<PolygonVertex> m_polygonPieceVertices = {}; // Reused by every split mesh
+            std::vector<unsigned int> m_polygonPieceIndices = {};
+            std::vector<int> m_polygonPieceRemap = {}; // Each mesh vertex's index in the current piece, or -1
+            std::vector<unsigned int> m_polygonPieceSources = {}; // The mesh vertex of every piece vertex, to reset the remap between pieces
+            std::shared_ptr<VertexArray> m_polygonVertexArray = nullptr; // Both read from the streaming buffer, when drawing
+            std::shared_ptr<VertexArray> m_circleVertexArray = nullptr;
+            std::vector<DrawIndexedCommand> m_geometryDraws = {}; // Reused by every geometry pool submission
+            static constexpr unsigned int m_cameraUniformBlockBinding = 0;
+            std::shared_ptr<UniformBuffer> m_cameraUniformBuffer = nullptr;
             std::shared_ptr<Texture> m_whiteTexture = nullptr;
             ShaderLibrary m_shaderLibrary;
+            std::array<std::shared_ptr<Shader>, 2> m_polygonShaders = {}; // Indexed by textured
+            std::array<std::shared_ptr<Shader>, 4> m_circleShaders = {}; // Indexed by textured + 2 * faded
 
-            RendererStorage() : m_viewProjectionMatrix(OrthographicCamera::getDefaultViewProjectionMatrix()) {}
+            RendererStorage() = default;
 
         };
 
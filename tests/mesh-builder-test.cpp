@@ -0,0 +1,184 @@
+// Triangulates large generated outlines with MeshBuilder, and checks the triangle counts, the winding, and that the
+// triangles cover exactly the outline's area. Returns non-zero if any check fails
+
+#include "MeshBuilder.h"
+#include "test-utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using engine::MeshBuilder;
+using engine::PolygonMesh;
+using engine::PolygonVertex;
+
+// Absolute, whatever the winding
+static double getOutlineArea(const std::vector<glm::vec2>& outline) {
+
+    double area = 0.0;
+    for (unsigned int i = 0; i < outline.size(); i++) {
+        const glm::vec2& point = outline[i];
+        const glm::vec2& next = outline[(i + 1) % outline.size()];
+        area += ((double) point.x * next.y - (double) point.y * next.x) / 2.0;
+    }
+
+    return std::abs(area);
+
+}
+
+// Triangulates the outline, in both windings, and expects the given number of triangles, covering the outline exactly
+static void checkPolygon(const std::string& name, std::vector<glm::vec2> outline, unsigned int triangleCount) {
+
+    double outlineArea = getOutlineArea(outline);
+
+    for (unsigned int winding = 0; winding < 2; winding++) {
+
+        std::string windingName = name + (winding ? " (clockwise)" : " (counter-clockwise)");
+
+        MeshBuilder builder;
+        builder.addPolygon(outline);
+        PolygonMesh mesh = builder.build();
+
+        unsigned int builtCount = mesh.getIndices().size() / 3;
+        check(builtCount == triangleCount, windingName, std::to_string(builtCount) + " triangles, instead of " + std::to_string(triangleCount));
+
+        double meshArea = getMeshArea(mesh, windingName);
+        check(std::abs(meshArea - outlineArea) <= outlineArea * 1e-5, windingName, "the triangles cover " + std::to_string(meshArea) + ", instead of " + std::to_string(outlineArea));
+
+        std::reverse(outline.begin(), outline.end());
+
+    }
+
+}
+
+// Alternating between an outer and an inner radius
+static std::vector<glm::vec2> makeStar(unsigned int pointCount) {
+
+    std::vector<glm::vec2> outline;
+    for (unsigned int i = 0; i < pointCount; i++) {
+        float angle = 6.2831853f * i / pointCount;
+        float radius = i % 2 ? 1.0f : 0.5f;
+        outline.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    return outline;
+
+}
+
+// Thin teeth standing on a bar, so most corners are reflex, or ears right next to one
+static std::vector<glm::vec2> makeComb(unsigned int toothCount) {
+
+    std::vector<glm::vec2> outline = {{(float) toothCount, -1.0f}, {(float) toothCount, 0.0f}};
+    for (unsigned int tooth = toothCount; tooth-- > 0;) {
+        outline.emplace_back(tooth + 0.75f, 0.0f);
+        outline.emplace_back(tooth + 0.75f, 10.0f);
+        outline.emplace_back(tooth + 0.25f, 10.0f);
+        outline.emplace_back(tooth + 0.25f, 0.0f);
+    }
+    outline.emplace_back(0.0f, 0.0f);
+    outline.emplace_back(0.0f, -1.0f);
+
+    return outline;
+
+}
+
+// A band winding outwards several turns, its inner edge out and its outer edge back in
+static std::vector<glm::vec2> makeSpiral(unsigned int pointCount) {
+
+    unsigned int sideCount = pointCount / 2;
+    float turnCount = 4.0f;
+    auto getPoint = [&](unsigned int i, float offset) {
+        float t = (float) i / (sideCount - 1);
+        float angle = t * turnCount * 6.2831853f;
+        float radius = 1.0f + t * turnCount + offset;
+        return glm::vec2(radius * std::cos(angle), radius * std::sin(angle));
+    };
+
+    std::vector<glm::vec2> outline;
+    for (unsigned int i = 0; i < sideCount; i++) {
+        outline.push_back(getPoint(i, 0.0f));
+    }
+    for (unsigned int i = sideCount; i-- > 0;) {
+        outline.push_back(getPoint(i, 0.5f));
+    }
+
+    return outline;
+
+}
+
+// Every point twice in a row: the repeats weld to the same vertex, and add no triangles
+static void checkDuplicatePoints() {
+
+    std::vector<glm::vec2> star = makeStar(200);
+    std::vector<glm::vec2> outline;
+    for (auto& point : star) {
+        outline.push_back(point);
+        outline.push_back(point);
+    }
+
+    MeshBuilder builder;
+    builder.addPolygon(outline);
+    check(builder.getVertexCount() == star.size(), "Duplicate points", std::to_string(builder.getVertexCount()) + " vertices, instead of " + std::to_string(star.size()));
+
+    PolygonMesh mesh = builder.build();
+    double meshArea = getMeshArea(mesh, "Duplicate points");
+    double outlineArea = getOutlineArea(star);
+    check(std::abs(meshArea - outlineArea) <= outlineArea * 1e-5, "Duplicate points", "the triangles cover " + std::to_string(meshArea) + ", instead of " + std::to_string(outlineArea));
+
+}
+
+// A grid of quads, added as separate triangles: the shared corners weld, and build() renumbers them by first use
+static void checkWeldedGrid() {
+
+    const unsigned int size = 100;
+    auto getVertex = [](unsigned int x, unsigned int y) {
+        return PolygonVertex({(float) x, (float) y, 0.0f, 1.0f}, {(float) x / size, (float) y / size});
+    };
+
+    MeshBuilder builder;
+    for (unsigned int y = 0; y < size; y++) {
+        for (unsigned int x = 0; x < size; x++) {
+            builder.addTriangle(getVertex(x, y), getVertex(x + 1, y), getVertex(x + 1, y + 1));
+            builder.addTriangle(getVertex(x + 1, y + 1), getVertex(x, y + 1), getVertex(x, y));
+        }
+    }
+
+    PolygonMesh mesh = builder.build();
+    check(mesh.getVertices().size() == (size + 1) * (size + 1), "Welded grid", std::to_string(mesh.getVertices().size()) + " vertices, instead of " + std::to_string((size + 1) * (size + 1)));
+    check(mesh.getIndices().size() == size * size * 6, "Welded grid", std::to_string(mesh.getIndices().size() / 3) + " triangles, instead of " + std::to_string(size * size * 2));
+
+    // Every index is at most one past the largest so far
+    unsigned int nextVertex = 0;
+    bool firstUseOrder = true;
+    for (auto index : mesh.getIndices()) {
+        firstUseOrder = firstUseOrder && index <= nextVertex;
+        if (index == nextVertex) {
+            nextVertex++;
+        }
+    }
+    check(firstUseOrder, "Welded grid", "the vertices aren't in the order of their first use");
+
+    double meshArea = getMeshArea(mesh, "Welded grid");
+    check(std::abs(meshArea - size * size) <= size * size * 1e-5, "Welded grid", "the triangles cover " + std::to_string(meshArea) + ", instead of " + std::to_string(size * size));
+
+}
+
+int main() {
+
+    checkPolygon("Star", makeStar(2000), 1998);
+    checkPolygon("Comb", makeComb(500), 2002);
+    checkPolygon("Spiral", makeSpiral(2000), 1998);
+    checkDuplicatePoints();
+    checkWeldedGrid();
+
+    if (failureCount) {
+        std::cerr << failureCount << " checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+
+}
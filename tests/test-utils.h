@@ -0,0 +1,43 @@
+#pragma once
+
+// The checks shared by the tests: each failed check is printed, and counted for main() to return non-zero
+
+#include "PolygonMesh.h"
+
+#include <iostream>
+#include <string>
+
+inline unsigned int failureCount = 0;
+
+inline void check(bool condition, const std::string& name, const std::string& message) {
+    if (!condition) {
+        std::cerr << name << ": " << message << std::endl;
+        failureCount++;
+    }
+}
+
+// Checks that every triangle is counter-clockwise, and returns their total area
+inline double getMeshArea(const engine::PolygonMesh& mesh, const std::string& name) {
+
+    auto& vertices = mesh.getVertices();
+    auto& indices = mesh.getIndices();
+
+    double area = 0.0;
+    bool counterClockwise = true;
+    for (unsigned int i = 0; i + 2 < indices.size(); i += 3) {
+
+        const glm::vec4& first = vertices[indices[i]].m_position;
+        const glm::vec4& second = vertices[indices[i + 1]].m_position;
+        const glm::vec4& third = vertices[indices[i + 2]].m_position;
+
+        double cross = ((double) second.x - first.x) * ((double) third.y - first.y) - ((double) second.y - first.y) * ((double) third.x - first.x);
+        counterClockwise = counterClockwise && cross > 0.0;
+        area += cross / 2.0;
+
+    }
+
+    check(counterClockwise, name, "a triangle isn't counter-clockwise");
+
+    return area;
+
+}
@@ -0,0 +1,188 @@
+// Flattens and tessellates vector paths, and checks the areas against the exact shapes, that paths which can't be
+// filled are outlined instead of failing, and that VectorPathCache shares and evicts the tessellations. Returns
+// non-zero if any check fails
+
+#include "VectorPath.h"
+#include "VectorPathCache.h"
+#include "test-utils.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using engine::MeshLibrary;
+using engine::PolygonMesh;
+using engine::PolygonMeshHandle;
+using engine::VectorPath;
+using engine::VectorPathCache;
+
+// The curves are flattened to within a fraction of a pixel, so the area converges as the scale grows
+static void checkFlattening() {
+
+    VectorPath path;
+    path.roundedRectangle({0.0f, 0.0f}, {4.0f, 2.0f}, 0.5f);
+    double exactArea = 8.0 - (4.0 - std::acos(-1.0)) * 0.25;
+
+    unsigned int previousCount = 0;
+    for (float scale : {1.0f, 10.0f, 100.0f}) {
+
+        std::string name = "Rounded rectangle at scale " + std::to_string((int) scale);
+        bool outlined;
+        PolygonMesh mesh = path.tessellate({true, 0.0f}, scale, outlined);
+        check(!outlined, name, "reported as outlined, instead of filled");
+
+        // Every point is within the tolerance of the exact outline, inside it, so the area is short by at most the perimeter times that
+        double area = getMeshArea(mesh, name);
+        double maxError = 12.0 * 0.25 / scale;
+        check(area <= exactArea + 1e-4 && exactArea - area <= maxError, name, "the triangles cover " + std::to_string(area) + ", instead of " + std::to_string(exactArea));
+
+        unsigned int count = mesh.getIndices().size() / 3;
+        check(count >= previousCount, name, "fewer triangles than at a smaller scale");
+        previousCount = count;
+
+    }
+
+    // A parabolic segment covers 2/3 of its bounding box. Its curve is under 15 units long
+    VectorPath arch;
+    arch.moveTo({0.0f, 0.0f}).quadTo({5.0f, 10.0f}, {10.0f, 0.0f}).close();
+    double archArea = getMeshArea(arch.tessellate({true, 0.0f}, 50.0f), "Arch");
+    double exactArchArea = 2.0 / 3.0 * 10.0 * 5.0;
+    check(archArea <= exactArchArea + 1e-4 && exactArchArea - archArea <= 15.0 * 0.25 / 50.0, "Arch", "the triangles cover " + std::to_string(archArea) + ", instead of " + std::to_string(exactArchArea));
+
+}
+
+// A 1 unit wide stroke along 2 segments of 10 units, plus the bevel on the outer side of the corner, and the inner side overlapping
+static void checkStroke() {
+
+    VectorPath path;
+    path.moveTo({0.0f, 0.0f}).lineTo({10.0f, 0.0f}).lineTo({10.0f, 10.0f});
+
+    double area = getMeshArea(path.tessellate({false, 1.0f}, 10.0f), "Stroke");
+    check(std::abs(area - 20.125) < 1e-3, "Stroke", "the triangles cover " + std::to_string(area) + ", instead of 20.125");
+
+}
+
+// A figure 8 and a bowtie can't be filled, so they're outlined: by a hairline without a stroke, or by the stroke
+static void checkSelfIntersecting() {
+
+    VectorPath figureEight;
+    figureEight.moveTo({0.0f, 0.0f})
+        .cubicTo({10.0f, 10.0f}, {10.0f, -10.0f}, {0.0f, 0.0f})
+        .cubicTo({-10.0f, 10.0f}, {-10.0f, -10.0f}, {0.0f, 0.0f})
+        .close();
+
+    VectorPath bowtie;
+    bowtie.moveTo({0.0f, 0.0f}).lineTo({10.0f, 10.0f}).lineTo({10.0f, 0.0f}).lineTo({0.0f, 10.0f}).close();
+
+    for (auto& [name, path] : {std::make_pair(std::string("Figure 8"), &figureEight), std::make_pair(std::string("Bowtie"), &bowtie)}) {
+
+        try {
+
+            bool outlined;
+            PolygonMesh hairline = path->tessellate({true, 0.0f}, 10.0f, outlined);
+            check(outlined, name, "outlined without reporting it");
+            check(!hairline.getIndices().empty(), name, "nothing drawn without a stroke");
+            check(getMeshArea(hairline, name) < 10.0, name, "filled, instead of outlined");
+
+            PolygonMesh stroked = path->tessellate({true, 0.5f}, 10.0f);
+            check(getMeshArea(stroked, name) < 40.0, name, "filled, instead of only stroked");
+
+        } catch (const std::exception& exception) {
+            check(false, name, std::string("threw: ") + exception.what());
+        }
+
+    }
+
+    // A subpath touching itself at a point can't be filled either
+    VectorPath touching;
+    touching.moveTo({0.0f, 0.0f}).lineTo({4.0f, 0.0f}).lineTo({4.0f, 4.0f}).lineTo({2.0f, 0.0f}).lineTo({0.0f, 4.0f}).close();
+    try {
+        PolygonMesh mesh = touching.tessellate({true, 0.0f}, 10.0f);
+        check(getMeshArea(mesh, "Touching") < 4.0, "Touching", "filled, instead of outlined");
+    } catch (const std::exception& exception) {
+        check(false, "Touching", std::string("threw: ") + exception.what());
+    }
+
+}
+
+// Scales within half an octave share a tessellation, and the ones left unused are evicted, along with their meshes
+static void checkCache() {
+
+    auto& cache = VectorPathCache::getInstance();
+    auto& library = MeshLibrary::getInstance();
+    cache.setMaxUnusedFrames(2);
+
+    VectorPath path;
+    path.roundedRectangle({0.0f, 0.0f}, {4.0f, 2.0f}, 0.5f);
+    VectorPath equalPath;
+    equalPath.roundedRectangle({0.0f, 0.0f}, {4.0f, 2.0f}, 0.5f);
+    VectorPath otherPath;
+    otherPath.roundedRectangle({0.0f, 0.0f}, {4.0f, 4.0f}, 0.5f);
+
+    PolygonMeshHandle mesh = cache.get(path, {true, 0.0f}, 10.0f);
+    check(cache.get(path, {true, 0.0f}, 9.0f) == mesh, "Cache", "a close scale wasn't shared");
+    check(cache.get(equalPath, {true, 0.0f}, 10.0f) == mesh, "Cache", "an equal path wasn't shared");
+    check(cache.get(path, {true, 0.0f}, 20.0f) != mesh, "Cache", "a scale an octave up was shared");
+    check(cache.getHitCount() == 2 && cache.getMissCount() == 2, "Cache", std::to_string(cache.getHitCount()) + " hits and " + std::to_string(cache.getMissCount()) + " misses, instead of 2 and 2");
+
+    PolygonMeshHandle otherMesh = cache.get(otherPath, {true, 0.0f}, 10.0f);
+    check(cache.getEntryCount() == 3 && library.getMeshCount() == 3, "Cache", std::to_string(cache.getEntryCount()) + " entries, instead of 3");
+
+    // Only the other path keeps being used
+    for (unsigned int frame = 0; frame < 4; frame++) {
+        cache.beginFrame();
+        check(cache.get(otherPath, {true, 0.0f}, 10.0f) == otherMesh, "Cache eviction", "a path in use was tessellated again");
+    }
+
+    check(cache.getEntryCount() == 1, "Cache eviction", std::to_string(cache.getEntryCount()) + " entries left, instead of 1");
+    check(!library.get(mesh), "Cache eviction", "an evicted mesh is still in the library");
+    check(library.getMeshCount() == 1, "Cache eviction", std::to_string(library.getMeshCount()) + " meshes left in the library, instead of 1");
+
+    cache.clear();
+    check(library.getMeshCount() == 0, "Cache", "meshes left in the library after clearing");
+
+}
+
+// A handle kept in a component, and only drawn after the one lookup, stays valid, the renderer touching it every frame
+static void checkHeldHandle() {
+
+    auto& cache = VectorPathCache::getInstance();
+    auto& library = MeshLibrary::getInstance();
+    cache.setMaxUnusedFrames(300);
+
+    VectorPath path;
+    path.roundedRectangle({0.0f, 0.0f}, {4.0f, 2.0f}, 0.5f);
+    PolygonMeshHandle mesh = cache.get(path, {true, 0.0f}, 10.0f);
+
+    for (unsigned int frame = 0; frame < 400; frame++) {
+        cache.beginFrame();
+        cache.touch(mesh);
+    }
+    check(library.get(mesh) != nullptr, "Held handle", "a mesh drawn every frame was evicted");
+
+    // Once it's no longer drawn, it's evicted as usual
+    for (unsigned int frame = 0; frame < 301; frame++) {
+        cache.beginFrame();
+    }
+    check(!library.get(mesh), "Held handle", "a mesh no longer drawn wasn't evicted");
+    check(cache.getEntryCount() == 0, "Held handle", std::to_string(cache.getEntryCount()) + " entries left, instead of 0");
+
+}
+
+int main() {
+
+    checkFlattening();
+    checkStroke();
+    checkSelfIntersecting();
+    checkCache();
+    checkHeldHandle();
+
+    if (failureCount) {
+        std::cerr << failureCount << " checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+
+}
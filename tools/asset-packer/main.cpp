@@ -0,0 +1,104 @@
+// Packs every file under a directory into a single asset pack, indexed by the hash of their relative path.
+// Usage: asset-packer <input directory> <output file>
+
+#include "AssetPackFormat.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct PackedFile {
+    std::string m_path; // Relative to the input directory, with '/' separators
+    std::vector<char> m_data;
+    engine::AssetPackEntry m_entry;
+};
+
+uint64_t alignOffset(uint64_t offset) {
+    return (offset + engine::ASSET_PACK_ALIGNMENT - 1) / engine::ASSET_PACK_ALIGNMENT * engine::ASSET_PACK_ALIGNMENT;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc < 3) {
+        std::cout << "Usage: asset-packer <input directory> <output file>" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path inputPath = argv[1];
+    std::string outputPath = argv[2];
+
+    if (!std::filesystem::is_directory(inputPath)) {
+        std::cout << "'" << inputPath.string() << "' is not a directory" << std::endl;
+        return 1;
+    }
+
+    std::vector<PackedFile> files;
+    for (const auto& directoryEntry : std::filesystem::recursive_directory_iterator(inputPath)) {
+
+        if (!directoryEntry.is_regular_file()) {
+            continue;
+        }
+
+        std::ifstream input(directoryEntry.path(), std::ios::binary);
+        if (!input) {
+            std::cout << "Failed to read '" << directoryEntry.path().string() << "'" << std::endl;
+            return 1;
+        }
+
+        PackedFile file;
+        file.m_path = std::filesystem::relative(directoryEntry.path(), inputPath).lexically_normal().generic_string();
+        file.m_data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        file.m_entry = {engine::hashAssetPath(file.m_path), 0, file.m_path.size(), 0, file.m_data.size()};
+        files.push_back(std::move(file));
+
+    }
+
+    // The runtime binary searches the index by hash
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+        return a.m_entry.m_pathHash < b.m_entry.m_pathHash || (a.m_entry.m_pathHash == b.m_entry.m_pathHash && a.m_path < b.m_path);
+    });
+
+    // The paths go right after the index, and then the data, each file aligned
+    uint64_t offset = sizeof(engine::AssetPackHeader) + files.size() * sizeof(engine::AssetPackEntry);
+    for (auto& file : files) {
+        file.m_entry.m_pathOffset = offset;
+        offset += file.m_path.size();
+    }
+    for (auto& file : files) {
+        offset = alignOffset(offset);
+        file.m_entry.m_dataOffset = offset;
+        offset += file.m_data.size();
+    }
+
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output) {
+        std::cout << "Failed to write '" << outputPath << "'" << std::endl;
+        return 1;
+    }
+
+    engine::AssetPackHeader header = {engine::ASSET_PACK_MAGIC, engine::ASSET_PACK_VERSION, files.size()};
+    output.write((const char*) &header, sizeof(header));
+
+    for (const auto& file : files) {
+        output.write((const char*) &file.m_entry, sizeof(file.m_entry));
+    }
+
+    for (const auto& file : files) {
+        output.write(file.m_path.data(), (std::streamsize) file.m_path.size());
+    }
+
+    for (const auto& file : files) {
+        std::vector<char> padding(file.m_entry.m_dataOffset - (uint64_t) output.tellp(), 0);
+        output.write(padding.data(), (std::streamsize) padding.size());
+        output.write(file.m_data.data(), (std::streamsize) file.m_data.size());
+    }
+
+    std::cout << "Packed " << files.size() << " files into '" << outputPath << "' (" << offset << " bytes)" << std::endl;
+
+    return 0;
+
+}
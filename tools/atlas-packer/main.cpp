@@ -0,0 +1,210 @@
+// Packs every image under a directory into as few atlas pages as possible, written as texture containers,
+// plus a lookup table mapping every image (by its relative path, without extension) to its page and UV rectangle.
+// Usage: atlas-packer <input directory> <output prefix> [--size 2048] [--padding 2]
+
+#include "TextureContainer.h"
+#include "skyline_packer.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Sprite {
+    std::string m_name;
+    int m_width;
+    int m_height;
+    std::vector<uint8_t> m_pixels; // RGBA
+    int m_page;
+    int m_x; // Of the sprite itself, inside its padding
+    int m_y;
+};
+
+struct Page {
+    engine::SkylinePacker m_packer;
+    std::vector<uint8_t> m_pixels; // RGBA
+};
+
+// Copies the sprite into the page, and repeats its edges into the padding, so filtering never samples a neighbour
+void blitSprite(const Sprite& sprite, std::vector<uint8_t>& pagePixels, int pageSize, int padding) {
+
+    for (int y = -padding; y < sprite.m_height + padding; y++) {
+        for (int x = -padding; x < sprite.m_width + padding; x++) {
+
+            int sourceX = std::min(std::max(x, 0), sprite.m_width - 1);
+            int sourceY = std::min(std::max(y, 0), sprite.m_height - 1);
+
+            const uint8_t* source = &sprite.m_pixels[(sourceY * sprite.m_width + sourceX) * 4];
+            uint8_t* destination = &pagePixels[((sprite.m_y + y) * pageSize + sprite.m_x + x) * 4];
+            std::copy(source, source + 4, destination);
+
+        }
+    }
+
+}
+
+bool writePage(const std::string& path, const std::vector<uint8_t>& pixels, int pageSize) {
+
+    engine::TextureContainerHeader header = {
+        engine::TEXTURE_CONTAINER_MAGIC,
+        engine::TEXTURE_CONTAINER_VERSION,
+        engine::TextureContainerFormat::RGBA8,
+        (uint32_t) pageSize,
+        (uint32_t) pageSize,
+        1
+    };
+
+    // A single level: mips would bleed the sprites into each other
+    engine::TextureContainerLevel level = {(uint32_t) pageSize, (uint32_t) pageSize, sizeof(header) + sizeof(level), pixels.size()};
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        return false;
+    }
+
+    output.write((const char*) &header, sizeof(header));
+    output.write((const char*) &level, sizeof(level));
+    output.write((const char*) pixels.data(), (std::streamsize) pixels.size());
+
+    return (bool) output;
+
+}
+
+int main(int argc, char** argv) {
+
+    if (argc < 3) {
+        std::cout << "Usage: atlas-packer <input directory> <output prefix> [--size 2048] [--padding 2]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path inputPath = argv[1];
+    std::string outputPrefix = argv[2];
+    int pageSize = 2048;
+    int padding = 2;
+
+    for (int i = 3; i < argc; i++) {
+
+        std::string argument = argv[i];
+
+        if (argument == "--size" && i + 1 < argc) {
+            pageSize = std::stoi(argv[++i]);
+        } else if (argument == "--padding" && i + 1 < argc) {
+            padding = std::stoi(argv[++i]);
+        } else {
+            std::cout << "Unknown argument '" << argument << "'" << std::endl;
+            return 1;
+        }
+
+    }
+
+    if (!std::filesystem::is_directory(inputPath)) {
+        std::cout << "'" << inputPath.string() << "' is not a directory" << std::endl;
+        return 1;
+    }
+
+    // Load every image, as RGBA, skipping anything stb_image can't read
+    std::vector<Sprite> sprites;
+    for (const auto& directoryEntry : std::filesystem::recursive_directory_iterator(inputPath)) {
+
+        if (!directoryEntry.is_regular_file()) {
+            continue;
+        }
+
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load(directoryEntry.path().string().c_str(), &width, &height, &channels, 4);
+        if (!pixels) {
+            continue;
+        }
+
+        Sprite sprite;
+        std::filesystem::path relativePath = std::filesystem::relative(directoryEntry.path(), inputPath);
+        sprite.m_name = relativePath.replace_extension().generic_string();
+
+        // The lookup table is whitespace-separated
+        if (sprite.m_name.find(' ') != std::string::npos) {
+            std::cout << "'" << sprite.m_name << "' has a space in its name" << std::endl;
+            stbi_image_free(pixels);
+            return 1;
+        }
+
+        sprite.m_width = width;
+        sprite.m_height = height;
+        sprite.m_pixels.assign(pixels, pixels + width * height * 4);
+        stbi_image_free(pixels);
+
+        if (width + 2 * padding > pageSize || height + 2 * padding > pageSize) {
+            std::cout << "'" << sprite.m_name << "' doesn't fit in a " << pageSize << "px page" << std::endl;
+            return 1;
+        }
+
+        sprites.push_back(std::move(sprite));
+
+    }
+
+    // Tallest first packs the skyline tighter
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.m_height > b.m_height || (a.m_height == b.m_height && a.m_width > b.m_width);
+    });
+
+    // Fill the existing pages before opening a new one
+    std::vector<Page> pages;
+    for (auto& sprite : sprites) {
+
+        int x, y;
+        sprite.m_page = -1;
+
+        for (int i = 0; i < (int) pages.size() && sprite.m_page < 0; i++) {
+            if (pages[i].m_packer.insert(sprite.m_width + 2 * padding, sprite.m_height + 2 * padding, x, y)) {
+                sprite.m_page = i;
+            }
+        }
+
+        if (sprite.m_page < 0) {
+            pages.push_back({engine::SkylinePacker(pageSize, pageSize), std::vector<uint8_t>((size_t) pageSize * pageSize * 4, 0)});
+            pages.back().m_packer.insert(sprite.m_width + 2 * padding, sprite.m_height + 2 * padding, x, y);
+            sprite.m_page = (int) pages.size() - 1;
+        }
+
+        sprite.m_x = x + padding;
+        sprite.m_y = y + padding;
+        blitSprite(sprite, pages[sprite.m_page].m_pixels, pageSize, padding);
+
+    }
+
+    // The lookup table references the pages relative to itself
+    std::ofstream lookupTable(outputPrefix + ".atlas", std::ios::trunc);
+    if (!lookupTable) {
+        std::cout << "Failed to open '" << outputPrefix << ".atlas' for writing" << std::endl;
+        return 1;
+    }
+
+    for (unsigned int i = 0; i < pages.size(); i++) {
+
+        std::string pagePath = outputPrefix + "-" + std::to_string(i) + ".tex";
+        if (!writePage(pagePath, pages[i].m_pixels, pageSize)) {
+            std::cout << "Failed to write '" << pagePath << "'" << std::endl;
+            return 1;
+        }
+
+        lookupTable << "page " << std::filesystem::path(pagePath).filename().string() << "\n";
+
+    }
+
+    // UVs follow the image rows, like any other texture: (0, 0) is the first pixel of the file
+    lookupTable.precision(9);
+    for (const auto& sprite : sprites) {
+        lookupTable << "region " << sprite.m_name << " " << sprite.m_page << " "
+            << (float) sprite.m_x / pageSize << " " << (float) sprite.m_y / pageSize << " "
+            << (float) (sprite.m_x + sprite.m_width) / pageSize << " " << (float) (sprite.m_y + sprite.m_height) / pageSize << "\n";
+    }
+
+    std::cout << "Packed " << sprites.size() << " images into " << pages.size() << " pages" << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace engine {
+
+    // Skyline bottom-left rectangle packing: the packed area is described by its top edge (the skyline),
+    // and every rectangle goes where its top ends up the lowest
+    class SkylinePacker {
+
+    public:
+        SkylinePacker(int width, int height) : m_width(width), m_height(height), m_nodes({{0, 0, width}}) {}
+
+        bool insert(int width, int height, int& x, int& y) {
+
+            int bestIndex = -1;
+            int bestTop = std::numeric_limits<int>::max();
+            int bestWidth = std::numeric_limits<int>::max();
+
+            for (int i = 0; i < (int) m_nodes.size(); i++) {
+
+                int top;
+                if (!fit(i, width, height, top)) {
+                    continue;
+                }
+
+                // Lowest top first, then the narrowest segment, to leave wide gaps open
+                if (top < bestTop || (top == bestTop && m_nodes[i].m_width < bestWidth)) {
+                    bestIndex = i;
+                    bestTop = top;
+                    bestWidth = m_nodes[i].m_width;
+                }
+
+            }
+
+            if (bestIndex < 0) {
+                return false;
+            }
+
+            x = m_nodes[bestIndex].m_x;
+            y = bestTop - height;
+            addNode(bestIndex, x, bestTop, width);
+
+            return true;
+
+        }
+
+    private:
+
+        struct Node {
+            int m_x;
+            int m_y;
+            int m_width;
+        };
+
+        int m_width;
+        int m_height;
+        std::vector<Node> m_nodes;
+
+        // Where the top of the rectangle would be, if placed at the start of the node
+        bool fit(int index, int width, int height, int& top) {
+
+            int x = m_nodes[index].m_x;
+            if (x + width > m_width) {
+                return false;
+            }
+
+            int y = 0;
+            int remainingWidth = width;
+            for (int i = index; remainingWidth > 0; i++) {
+                y = std::max(y, m_nodes[i].m_y);
+                remainingWidth -= m_nodes[i].m_width;
+            }
+
+            top = y + height;
+            return top <= m_height;
+
+        }
+
+        void addNode(int index, int x, int y, int width) {
+
+            m_nodes.insert(m_nodes.begin() + index, {x, y, width});
+
+            // Shrink or remove the nodes now under the new one
+            for (int i = index + 1; i < (int) m_nodes.size(); i++) {
+
+                int overlap = x + width - m_nodes[i].m_x;
+                if (overlap <= 0) {
+                    break;
+                }
+
+                if (overlap < m_nodes[i].m_width) {
+                    m_nodes[i].m_x += overlap;
+                    m_nodes[i].m_width -= overlap;
+                    break;
+                }
+
+                m_nodes.erase(m_nodes.begin() + i);
+                i--;
+
+            }
+
+            // Merge neighbours at the same height
+            for (int i = 0; i + 1 < (int) m_nodes.size(); i++) {
+                if (m_nodes[i].m_y == m_nodes[i + 1].m_y) {
+                    m_nodes[i].m_width += m_nodes[i + 1].m_width;
+                    m_nodes.erase(m_nodes.begin() + i + 1);
+                    i--;
+                }
+            }
+
+        }
+
+    };
+
+}
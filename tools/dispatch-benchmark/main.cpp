@@ -0,0 +1,134 @@
+// Measures what a render call costs to dispatch, the three ways RenderCommand can reach the render API:
+// through the virtual interface, through the per-thread API pointer RenderCommand uses by default, and bound at
+// compile time, as with STATIC_RENDER_API. The APIs only sum their arguments, so the dispatch is all that's measured.
+// Usage: dispatch-benchmark [draw count, 10000000 by default]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// The calls a draw makes, in the shape of engine::RenderApi
+class BenchmarkApi {
+
+public:
+    virtual ~BenchmarkApi() = default;
+    virtual void bindTexture(unsigned int id, unsigned int slot) = 0;
+    virtual void setUniform4f(int location, const float* value) = 0;
+    virtual void drawIndexedTriangles(unsigned int indexCount) = 0;
+    virtual unsigned long getChecksum() const = 0;
+
+};
+
+class NullApi final : public BenchmarkApi {
+
+private:
+    unsigned long m_checksum = 0;
+
+public:
+    void bindTexture(unsigned int id, unsigned int slot) override {m_checksum += id + slot;}
+    void setUniform4f(int location, const float* value) override {m_checksum += location + (value[0] > 0.0f);}
+    void drawIndexedTriangles(unsigned int indexCount) override {m_checksum += indexCount;}
+    unsigned long getChecksum() const override {return m_checksum;}
+
+};
+
+// Like NullApi, but a different type, so the compiler can't assume every call lands on NullApi
+class RecordingApi final : public BenchmarkApi {
+
+private:
+    unsigned long m_checksum = 0;
+
+public:
+    void bindTexture(unsigned int id, unsigned int slot) override {m_checksum += id + slot;}
+    void setUniform4f(int location, const float* value) override {m_checksum += location + (value[0] > 0.0f);}
+    void drawIndexedTriangles(unsigned int indexCount) override {m_checksum += indexCount;}
+    unsigned long getChecksum() const override {return m_checksum;}
+
+};
+
+// RenderCommand's default: a facade over a per-thread pointer to the API
+class ThreadLocalCommand {
+
+public:
+    static thread_local BenchmarkApi* m_apiInstance;
+
+    static void bindTexture(unsigned int id, unsigned int slot) {m_apiInstance->bindTexture(id, slot);}
+    static void setUniform4f(int location, const float* value) {m_apiInstance->setUniform4f(location, value);}
+    static void drawIndexedTriangles(unsigned int indexCount) {m_apiInstance->drawIndexedTriangles(indexCount);}
+
+};
+
+thread_local BenchmarkApi* ThreadLocalCommand::m_apiInstance = nullptr;
+
+// RenderCommand with STATIC_RENDER_API: a facade bound to the final backend class
+class StaticCommand {
+
+public:
+    static NullApi& getApi() {
+        static NullApi api;
+        return api;
+    }
+
+    static void bindTexture(unsigned int id, unsigned int slot) {getApi().bindTexture(id, slot);}
+    static void setUniform4f(int location, const float* value) {getApi().setUniform4f(location, value);}
+    static void drawIndexedTriangles(unsigned int indexCount) {getApi().drawIndexedTriangles(indexCount);}
+
+};
+
+// Runs the draws, and prints how long each took on average
+template<typename Function>
+void measure(const std::string& name, unsigned long drawCount, Function draw) {
+
+    const float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < drawCount; i++) {
+        draw((unsigned int) (i & 7u), color);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << name << ": " << nanoseconds / drawCount << " ns per draw (3 calls)" << std::endl;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    unsigned long drawCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    if (!drawCount) {
+        std::cerr << "Usage: dispatch-benchmark [draw count]" << std::endl;
+        return 1;
+    }
+
+    // Picked at run time, through a volatile, so the virtual calls stay virtual
+    volatile bool recording = false;
+    NullApi nullApi;
+    RecordingApi recordingApi;
+    BenchmarkApi& api = recording ? static_cast<BenchmarkApi&>(recordingApi) : nullApi;
+    ThreadLocalCommand::m_apiInstance = &api;
+
+    measure("Virtual", drawCount, [&api](unsigned int index, const float* color) {
+        api.bindTexture(index, 0);
+        api.setUniform4f(0, color);
+        api.drawIndexedTriangles(6);
+    });
+
+    measure("Thread local", drawCount, [](unsigned int index, const float* color) {
+        ThreadLocalCommand::bindTexture(index, 0);
+        ThreadLocalCommand::setUniform4f(0, color);
+        ThreadLocalCommand::drawIndexedTriangles(6);
+    });
+
+    measure("Static", drawCount, [](unsigned int index, const float* color) {
+        StaticCommand::bindTexture(index, 0);
+        StaticCommand::setUniform4f(0, color);
+        StaticCommand::drawIndexedTriangles(6);
+    });
+
+    // Printed, so none of the calls can be optimized away
+    std::cout << "Checksum: " << api.getChecksum() + StaticCommand::getApi().getChecksum() << std::endl;
+
+    return 0;
+
+}
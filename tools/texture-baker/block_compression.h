@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Minimal BC1/BC3 (DXT1/DXT5) encoders: the block endpoints are the corners of the block's bounding box in color space,
+// picking the diagonal that follows the colors. Not as good as a PCA fit, but fast, and good enough for sprites
+namespace engine {
+
+    inline uint16_t packColor565(const uint8_t* color) {
+        return (uint16_t) (((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+    }
+
+    inline void unpackColor565(uint16_t packed, uint8_t* color) {
+        color[0] = (uint8_t) (((packed >> 11) & 0x1f) * 255 / 31);
+        color[1] = (uint8_t) (((packed >> 5) & 0x3f) * 255 / 63);
+        color[2] = (uint8_t) ((packed & 0x1f) * 255 / 31);
+    }
+
+    // block: 16 RGBA pixels, output: 8 bytes
+    inline void compressColorBlock(const uint8_t* block, uint8_t* output) {
+
+        uint8_t minColor[3] = {255, 255, 255};
+        uint8_t maxColor[3] = {0, 0, 0};
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                minColor[c] = std::min(minColor[c], block[i * 4 + c]);
+                maxColor[c] = std::max(maxColor[c], block[i * 4 + c]);
+            }
+        }
+
+        // The box has 4 diagonals: flip the channels that go against the one with the largest range
+        int mainChannel = 0;
+        for (int c = 1; c < 3; c++) {
+            if (maxColor[c] - minColor[c] > maxColor[mainChannel] - minColor[mainChannel]) {
+                mainChannel = c;
+            }
+        }
+
+        int mean[3] = {0, 0, 0};
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                mean[c] += block[i * 4 + c];
+            }
+        }
+
+        for (int c = 0; c < 3; c++) {
+
+            if (c == mainChannel) {
+                continue;
+            }
+
+            int covariance = 0;
+            for (int i = 0; i < 16; i++) {
+                covariance += (block[i * 4 + c] * 16 - mean[c]) * (block[i * 4 + mainChannel] * 16 - mean[mainChannel]);
+            }
+
+            if (covariance < 0) {
+                std::swap(minColor[c], maxColor[c]);
+            }
+
+        }
+
+        uint16_t color0 = packColor565(maxColor);
+        uint16_t color1 = packColor565(minColor);
+
+        // color0 > color1 selects the 4-color mode, which is the only one BC3 supports
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        uint8_t palette[4][3];
+        unpackColor565(color0, palette[0]);
+        unpackColor565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (uint8_t) ((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = (uint8_t) ((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            for (int i = 0; i < 16; i++) {
+
+                int bestIndex = 0;
+                int bestDistance = 1 << 30;
+                for (int p = 0; p < 4; p++) {
+                    int distance = 0;
+                    for (int c = 0; c < 3; c++) {
+                        int delta = (int) block[i * 4 + c] - (int) palette[p][c];
+                        distance += delta * delta;
+                    }
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= (uint32_t) bestIndex << (i * 2);
+
+            }
+        }
+
+        output[0] = (uint8_t) (color0 & 0xff);
+        output[1] = (uint8_t) (color0 >> 8);
+        output[2] = (uint8_t) (color1 & 0xff);
+        output[3] = (uint8_t) (color1 >> 8);
+        std::memcpy(output + 4, &indices, 4);
+
+    }
+
+    // block: 16 RGBA pixels, output: 8 bytes
+    inline void compressAlphaBlock(const uint8_t* block, uint8_t* output) {
+
+        uint8_t minAlpha = 255;
+        uint8_t maxAlpha = 0;
+        for (int i = 0; i < 16; i++) {
+            minAlpha = std::min(minAlpha, block[i * 4 + 3]);
+            maxAlpha = std::max(maxAlpha, block[i * 4 + 3]);
+        }
+
+        // alpha0 > alpha1 selects the 8-value mode
+        uint8_t palette[8];
+        palette[0] = maxAlpha;
+        palette[1] = minAlpha;
+        for (int p = 1; p < 7; p++) {
+            palette[p + 1] = (uint8_t) (((7 - p) * maxAlpha + p * minAlpha) / 7);
+        }
+
+        uint64_t indices = 0;
+        if (maxAlpha != minAlpha) {
+            for (int i = 0; i < 16; i++) {
+
+                int bestIndex = 0;
+                int bestDistance = 256;
+                for (int p = 0; p < 8; p++) {
+                    int distance = std::abs((int) block[i * 4 + 3] - (int) palette[p]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= (uint64_t) bestIndex << (i * 3);
+
+            }
+        }
+
+        output[0] = maxAlpha;
+        output[1] = minAlpha;
+        for (int i = 0; i < 6; i++) {
+            output[2 + i] = (uint8_t) ((indices >> (i * 8)) & 0xff);
+        }
+
+    }
+
+    // Compresses a whole RGBA image, block by block. Edge blocks repeat the last row/column
+    inline std::vector<uint8_t> compressImage(const uint8_t* pixels, unsigned int width, unsigned int height, bool withAlpha) {
+
+        unsigned int blocksX = (width + 3) / 4;
+        unsigned int blocksY = (height + 3) / 4;
+        unsigned int blockSize = withAlpha ? 16 : 8;
+
+        std::vector<uint8_t> output(blocksX * blocksY * blockSize);
+
+        uint8_t block[16 * 4];
+        for (unsigned int by = 0; by < blocksY; by++) {
+            for (unsigned int bx = 0; bx < blocksX; bx++) {
+
+                for (unsigned int y = 0; y < 4; y++) {
+                    for (unsigned int x = 0; x < 4; x++) {
+                        unsigned int sourceX = std::min(bx * 4 + x, width - 1);
+                        unsigned int sourceY = std::min(by * 4 + y, height - 1);
+                        std::memcpy(block + (y * 4 + x) * 4, pixels + (sourceY * width + sourceX) * 4, 4);
+                    }
+                }
+
+                uint8_t* blockOutput = output.data() + (by * blocksX + bx) * blockSize;
+                if (withAlpha) {
+                    compressAlphaBlock(block, blockOutput);
+                    compressColorBlock(block, blockOutput + 8);
+                } else {
+                    compressColorBlock(block, blockOutput);
+                }
+
+            }
+        }
+
+        return output;
+
+    }
+
+}
@@ -0,0 +1,154 @@
+// Bakes an image into the engine's texture container: the full mip chain, optionally block-compressed.
+// Usage: texture-baker <input image> <output file> [--format rgba8|bc1|bc3] [--no-mips]
+
+#include "TextureContainer.h"
+#include "block_compression.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct MipLevel {
+    unsigned int m_width;
+    unsigned int m_height;
+    std::vector<uint8_t> m_pixels; // RGBA
+};
+
+// Box filter, where odd dimensions repeat the last row/column
+MipLevel downsample(const MipLevel& level) {
+
+    MipLevel next;
+    next.m_width = std::max(1u, level.m_width / 2);
+    next.m_height = std::max(1u, level.m_height / 2);
+    next.m_pixels.resize(next.m_width * next.m_height * 4);
+
+    for (unsigned int y = 0; y < next.m_height; y++) {
+        for (unsigned int x = 0; x < next.m_width; x++) {
+
+            unsigned int x0 = std::min(x * 2, level.m_width - 1), x1 = std::min(x * 2 + 1, level.m_width - 1);
+            unsigned int y0 = std::min(y * 2, level.m_height - 1), y1 = std::min(y * 2 + 1, level.m_height - 1);
+
+            for (unsigned int c = 0; c < 4; c++) {
+                unsigned int sum = level.m_pixels[(y0 * level.m_width + x0) * 4 + c]
+                    + level.m_pixels[(y0 * level.m_width + x1) * 4 + c]
+                    + level.m_pixels[(y1 * level.m_width + x0) * 4 + c]
+                    + level.m_pixels[(y1 * level.m_width + x1) * 4 + c];
+                next.m_pixels[(y * next.m_width + x) * 4 + c] = (uint8_t) ((sum + 2) / 4);
+            }
+
+        }
+    }
+
+    return next;
+
+}
+
+int main(int argc, char** argv) {
+
+    if (argc < 3) {
+        std::cout << "Usage: texture-baker <input image> <output file> [--format rgba8|bc1|bc3] [--no-mips]" << std::endl;
+        return 1;
+    }
+
+    std::string inputPath = argv[1];
+    std::string outputPath = argv[2];
+    engine::TextureContainerFormat format = engine::TextureContainerFormat::RGBA8;
+    bool generateMips = true;
+
+    for (int i = 3; i < argc; i++) {
+
+        std::string argument = argv[i];
+
+        if (argument == "--no-mips") {
+            generateMips = false;
+        } else if (argument == "--format" && i + 1 < argc) {
+            std::string formatName = argv[++i];
+            if (formatName == "rgba8") {
+                format = engine::TextureContainerFormat::RGBA8;
+            } else if (formatName == "bc1") {
+                format = engine::TextureContainerFormat::BC1;
+            } else if (formatName == "bc3") {
+                format = engine::TextureContainerFormat::BC3;
+            } else {
+                std::cout << "Unknown format '" << formatName << "'" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cout << "Unknown argument '" << argument << "'" << std::endl;
+            return 1;
+        }
+
+    }
+
+    // Always decode as RGBA, so every level and block has the same layout
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(inputPath.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cout << "Failed to load '" << inputPath << "': " << stbi_failure_reason() << std::endl;
+        return 1;
+    }
+
+    std::vector<MipLevel> levels(1);
+    levels[0].m_width = (unsigned int) width;
+    levels[0].m_height = (unsigned int) height;
+    levels[0].m_pixels.assign(pixels, pixels + width * height * 4);
+    stbi_image_free(pixels);
+
+    while (generateMips && (levels.back().m_width > 1 || levels.back().m_height > 1)) {
+        levels.push_back(downsample(levels.back()));
+    }
+
+    // Encode every level, in its final format
+    std::vector<std::vector<uint8_t> > levelData;
+    for (const auto& level : levels) {
+        switch (format) {
+            case engine::TextureContainerFormat::RGBA8:
+                levelData.push_back(level.m_pixels);
+                break;
+            case engine::TextureContainerFormat::BC1:
+                levelData.push_back(engine::compressImage(level.m_pixels.data(), level.m_width, level.m_height, false));
+                break;
+            case engine::TextureContainerFormat::BC3:
+                levelData.push_back(engine::compressImage(level.m_pixels.data(), level.m_width, level.m_height, true));
+                break;
+        }
+    }
+
+    engine::TextureContainerHeader header = {
+        engine::TEXTURE_CONTAINER_MAGIC,
+        engine::TEXTURE_CONTAINER_VERSION,
+        format,
+        (uint32_t) width,
+        (uint32_t) height,
+        (uint32_t) levels.size()
+    };
+
+    // The level data starts right after the level table
+    std::vector<engine::TextureContainerLevel> levelTable;
+    uint64_t offset = sizeof(engine::TextureContainerHeader) + levels.size() * sizeof(engine::TextureContainerLevel);
+    for (unsigned int i = 0; i < levels.size(); i++) {
+        levelTable.push_back({levels[i].m_width, levels[i].m_height, offset, levelData[i].size()});
+        offset += levelData[i].size();
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cout << "Failed to open '" << outputPath << "' for writing" << std::endl;
+        return 1;
+    }
+
+    output.write((const char*) &header, sizeof(header));
+    output.write((const char*) levelTable.data(), (std::streamsize) (levelTable.size() * sizeof(engine::TextureContainerLevel)));
+    for (const auto& data : levelData) {
+        output.write((const char*) data.data(), (std::streamsize) data.size());
+    }
+
+    std::cout << "Baked '" << inputPath << "' (" << width << "x" << height << ", " << levels.size() << " levels, " << offset << " bytes)" << std::endl;
+
+    return 0;
+
+}